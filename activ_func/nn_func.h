@@ -0,0 +1,83 @@
+#ifndef NN_FUNC_H
+#define NN_FUNC_H
+
+#include <stddef.h>
+
+double sigmoid(double input_value);
+double sigmoid_error_handl(double input_value);
+double sigmoid_derivative(double input_value);
+double tanh_activation(double input_value);
+double tanh_derivative(double input_value);
+double relu(double input_value);
+double relu_derivative(double input_value);
+double leaky_relu(double input_value);
+double leaky_relu_derivative(double input_value, double alpha);
+double hard_sigmoid(double input_value);
+double hard_sigmoid_derivative(double input_value);
+double linear(double input_value);
+double linear_derivative(double input_value);
+double elu(double input_value, double alpha);
+double elu_derivative(double input_value, double alpha);
+double swish(double input_value);
+double swish_derivative(double input_value);
+
+void sigmoid_array(const double *input, double *output, size_t n);
+void tanh_array(const double *input, double *output, size_t n);
+void relu_array(const double *input, double *output, size_t n);
+void leaky_relu_array(const double *input, double *output, size_t n, double alpha);
+void elu_array(const double *input, double *output, size_t n, double alpha);
+void swish_array(const double *input, double *output, size_t n);
+void hard_sigmoid_array(const double *input, double *output, size_t n);
+void linear_array(const double *input, double *output, size_t n);
+
+void sigmoid_array_inplace(double *values, size_t n);
+void tanh_array_inplace(double *values, size_t n);
+void relu_array_inplace(double *values, size_t n);
+void leaky_relu_array_inplace(double *values, size_t n, double alpha);
+void elu_array_inplace(double *values, size_t n, double alpha);
+void swish_array_inplace(double *values, size_t n);
+void hard_sigmoid_array_inplace(double *values, size_t n);
+
+void sigmoid_derivative_array(const double *output, double *derivative, size_t n);
+void tanh_derivative_array(const double *output, double *derivative, size_t n);
+void relu_derivative_array(const double *output, double *derivative, size_t n);
+void leaky_relu_derivative_array(const double *output, double *derivative, size_t n, double alpha);
+void elu_derivative_array(const double *output, double *derivative, size_t n, double alpha);
+void swish_derivative_array(const double *input, const double *output, double *derivative, size_t n);
+void hard_sigmoid_derivative_array(const double *output, double *derivative, size_t n);
+void linear_derivative_array(const double *output, double *derivative, size_t n);
+
+/*
+ * Fast vectorizable approximations. fast_exp is accurate to
+ * FAST_EXP_MAX_REL_ERROR (relative) on [FAST_EXP_MIN, FAST_EXP_MAX] and
+ * returns 0 below / +inf above it. Sigmoid and tanh are bounded, so their
+ * bounds are absolute and hold over the whole double range, infinities
+ * included; NaN propagates.
+ */
+#define FAST_EXP_MIN -708.0
+#define FAST_EXP_MAX 709.0
+#define FAST_EXP_MAX_REL_ERROR 1e-12
+#define FAST_SIGMOID_MAX_ABS_ERROR 1e-12
+#define FAST_TANH_MAX_ABS_ERROR 1e-12
+
+double fast_exp(double input_value);
+double fast_sigmoid(double input_value);
+double fast_tanh(double input_value);
+void exp_array_fast(const double *input, double *output, size_t n);
+void sigmoid_array_fast(const double *input, double *output, size_t n);
+void tanh_array_fast(const double *input, double *output, size_t n);
+void elu_array_fast(const double *input, double *output, size_t n, double alpha);
+void swish_array_fast(const double *input, double *output, size_t n);
+
+void softmax_array(const double *input, double *output, size_t n);
+void softmax_rows(const double *input, double *output, size_t rows, size_t cols);
+double softmax_cross_entropy_rows(const double *logits, const size_t *labels, double *grad,
+                                  size_t rows, size_t cols);
+double softmax_cross_entropy_targets_rows(const double *logits, const double *targets, double *grad,
+                                          size_t rows, size_t cols);
+
+void test_activation_arrays(void);
+void test_fast_activations(void);
+void test_softmax_cross_entropy(void);
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef _WIN32
+    #define _POSIX_C_SOURCE 200809L
+#endif
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -9,7 +12,8 @@
     #define strcpy_s(dest, size, src) strncpy(dest, src, size)
     #define strncpy_s(dest, size, src, count) strncpy(dest, src, count)
     #define sscanf_s sscanf
-    #define fopen_s(fp, filename, mode) ((*fp = fopen(filename, mode)) == NULL ? -1 : 0)
+    #define fopen_s(fp, filename, mode) ((*fp = fopen(filename, mode)) == NULL ? errno : 0)
+    typedef int errno_t;
 
     // strtok_s replacement
     char* strtok_s(char* str, const char* delim, char** context) {
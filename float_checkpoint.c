@@ -0,0 +1,482 @@
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "float_matrix.h"
+#include "float_mlp.h"
+#include "float_optim.h"
+#include "float_checkpoint.h"
+
+#define CHECKPOINT_BYTE_ORDER 0x01020304u
+
+/*
+ * On-disk header; every field is 8 bytes wide but the version and byte
+ * order pair, so the layout has no padding. optimizer is 0 without one,
+ * otherwise its FloatOptimizerKind + 1; a state offset of 0 means the
+ * vector is absent. The size and activation tables follow directly.
+ */
+typedef struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t layer_count;
+    uint64_t activation_mode;
+    uint64_t parameter_count;
+    uint64_t parameter_offset;
+    uint64_t optimizer;
+    uint64_t step;
+    double learning_rate;
+    double beta1;
+    double beta2;
+    double epsilon;
+    uint64_t first_offset;
+    uint64_t second_offset;
+} CheckpointHeader;
+
+static size_t align_offset(size_t n) {
+    return (n + FLOAT_CHECKPOINT_ALIGN - 1) & ~(size_t)(FLOAT_CHECKPOINT_ALIGN - 1);
+}
+
+/* Writes zeros until the file reaches offset. */
+static int pad_to(FILE *file, size_t *position, size_t offset) {
+    static const char zeros[512];
+    while (*position < offset) {
+        size_t n = offset - *position < sizeof(zeros) ? offset - *position : sizeof(zeros);
+        if (fwrite(zeros, 1, n, file) != n) return -1;
+        *position += n;
+    }
+    return 0;
+}
+
+static int write_at(FILE *file, size_t *position, size_t offset, const void *data, size_t bytes) {
+    if (pad_to(file, position, offset) != 0 || fwrite(data, 1, bytes, file) != bytes) {
+        return -1;
+    }
+    *position += bytes;
+    return 0;
+}
+
+/*
+ * Writes to path.tmp and renames it over path once it is on disk, so a
+ * crash mid-save leaves the previous checkpoint intact. The optimizer
+ * state is included when the network has an optimizer set.
+ */
+int float_checkpoint_save(const char *path, FloatMLP *mlp) {
+    size_t layers = mlp->layer_count;
+    size_t bytes = mlp->parameter_count * sizeof(double);
+    FloatOptimizer *opt = mlp->optimizer;
+
+    CheckpointHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, FLOAT_CHECKPOINT_MAGIC, 8);
+    h.version = FLOAT_CHECKPOINT_VERSION;
+    h.byte_order = CHECKPOINT_BYTE_ORDER;
+    h.layer_count = layers;
+    h.activation_mode = (uint64_t)mlp->activation_mode;
+    h.parameter_count = mlp->parameter_count;
+    size_t offset = align_offset(sizeof(h) + (2 * layers + 1) * sizeof(uint64_t));
+    h.parameter_offset = offset;
+    offset = align_offset(offset + bytes);
+    if (opt != NULL) {
+        h.optimizer = (uint64_t)opt->kind + 1;
+        h.step = opt->step;
+        h.learning_rate = opt->learning_rate;
+        h.beta1 = opt->beta1;
+        h.beta2 = opt->beta2;
+        h.epsilon = opt->epsilon;
+        if (opt->first != NULL) {
+            h.first_offset = offset;
+            offset = align_offset(offset + bytes);
+        }
+        if (opt->second != NULL) {
+            h.second_offset = offset;
+            offset = align_offset(offset + bytes);
+        }
+    }
+    h.file_size = offset;
+
+    uint64_t *tables = (uint64_t *)malloc((2 * layers + 1) * sizeof(uint64_t));
+    char *tmp_path = (char *)malloc(strlen(path) + 5);
+    if (tables == NULL || tmp_path == NULL) {
+        perror("Failed to allocate memory for checkpoint");
+        free(tables);
+        free(tmp_path);
+        return -1;
+    }
+    tables[0] = mlp->layers[0].inputs;
+    for (size_t l = 0; l < layers; l++) {
+        tables[l + 1] = mlp->layers[l].outputs;
+        tables[layers + 1 + l] = (uint64_t)mlp->layers[l].activation;
+    }
+    sprintf(tmp_path, "%s.tmp", path);
+
+    int status = -1;
+    size_t position = 0;
+    FILE *file = fopen(tmp_path, "wb");
+    if (file == NULL) {
+        perror("Failed to create checkpoint");
+    } else {
+        if (write_at(file, &position, 0, &h, sizeof(h)) == 0 &&
+            write_at(file, &position, sizeof(h), tables, (2 * layers + 1) * sizeof(uint64_t)) == 0 &&
+            write_at(file, &position, h.parameter_offset, mlp->parameters->data[0], bytes) == 0 &&
+            (h.first_offset == 0 ||
+             write_at(file, &position, h.first_offset, opt->first->data[0], bytes) == 0) &&
+            (h.second_offset == 0 ||
+             write_at(file, &position, h.second_offset, opt->second->data[0], bytes) == 0) &&
+            pad_to(file, &position, h.file_size) == 0 &&
+            fflush(file) == 0 && fsync(fileno(file)) == 0) {
+            status = 0;
+        }
+        if (fclose(file) != 0) {
+            status = -1;
+        }
+        if (status == 0 && rename(tmp_path, path) != 0) {
+            status = -1;
+        }
+        if (status != 0) {
+            perror("Failed to write checkpoint");
+            remove(tmp_path);
+        }
+    }
+    free(tables);
+    free(tmp_path);
+    return status;
+}
+
+/* A tensor of count doubles at offset: aligned, past the tables and inside the file. */
+static int tensor_fits(uint64_t offset, uint64_t count, uint64_t tables_end, uint64_t file_size) {
+    size_t bytes;
+    return offset % FLOAT_CHECKPOINT_ALIGN == 0 && offset >= tables_end && offset <= file_size &&
+           matrix_size_mul((size_t)count, sizeof(double), &bytes) && bytes <= file_size - offset;
+}
+
+static int header_valid(const CheckpointHeader *h, size_t file_size) {
+    if (h->file_size != file_size || h->layer_count == 0 ||
+        h->layer_count > file_size / (2 * sizeof(uint64_t)) ||
+        h->activation_mode > FLOAT_ACTIVATIONS_FAST || h->optimizer > FLOAT_OPTIM_ADAM + 1) {
+        return 0;
+    }
+    uint64_t tables_end = sizeof(CheckpointHeader) + (2 * h->layer_count + 1) * sizeof(uint64_t);
+    return tensor_fits(h->parameter_offset, h->parameter_count, tables_end, file_size) &&
+           (h->first_offset == 0 ||
+            tensor_fits(h->first_offset, h->parameter_count, tables_end, file_size)) &&
+           (h->second_offset == 0 ||
+            tensor_fits(h->second_offset, h->parameter_count, tables_end, file_size));
+}
+
+/* Builds the network over the mapped parameter block; NULL when the tables disagree with it. */
+static FloatMLP* wrap_mapping(const CheckpointHeader *h, char *mapping, size_t max_batch) {
+    size_t layers = (size_t)h->layer_count;
+    const uint64_t *tables = (const uint64_t *)(mapping + sizeof(CheckpointHeader));
+    size_t *sizes = (size_t *)malloc((layers + 1) * sizeof(size_t));
+    FloatActivation *activations = (FloatActivation *)malloc(layers * sizeof(FloatActivation));
+    FloatMLP *mlp = NULL;
+    int valid = sizes != NULL && activations != NULL;
+    for (size_t l = 0; valid && l <= layers; l++) {
+        sizes[l] = (size_t)tables[l];
+        valid = tables[l] > 0 && (l == layers || tables[layers + 1 + l] <= FLOAT_ACT_SOFTMAX);
+        if (valid && l < layers) {
+            activations[l] = (FloatActivation)tables[layers + 1 + l];
+        }
+    }
+    if (valid) {
+        mlp = float_mlp_wrap(sizes, activations, layers, max_batch,
+                             (double *)(mapping + h->parameter_offset));
+    }
+    if (mlp != NULL && mlp->parameter_count != h->parameter_count) {
+        dealloc_float_mlp(mlp);
+        mlp = NULL;
+    }
+    free(sizes);
+    free(activations);
+    return mlp;
+}
+
+/*
+ * Maps a checkpoint for serving. Only the header and tables are read;
+ * the network's weights are the mapped pages themselves.
+ */
+FloatCheckpoint* float_checkpoint_open(const char *path, size_t max_batch) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open checkpoint");
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(CheckpointHeader)) {
+        printf("Not a checkpoint file: %s\n", path);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        perror("Failed to map checkpoint");
+        return NULL;
+    }
+
+    CheckpointHeader h;
+    memcpy(&h, mapping, sizeof(h));
+    FloatMLP *mlp = NULL;
+    if (memcmp(h.magic, FLOAT_CHECKPOINT_MAGIC, 8) != 0) {
+        printf("Not a checkpoint file: %s\n", path);
+    } else if (h.version != FLOAT_CHECKPOINT_VERSION) {
+        printf("Checkpoint %s has version %u, expected %d\n", path, h.version, FLOAT_CHECKPOINT_VERSION);
+    } else if (h.byte_order != CHECKPOINT_BYTE_ORDER) {
+        printf("Checkpoint %s was written with another byte order\n", path);
+    } else if (!header_valid(&h, size) ||
+               (mlp = wrap_mapping(&h, (char *)mapping, max_batch)) == NULL) {
+        printf("Corrupt or truncated checkpoint: %s\n", path);
+    }
+    if (mlp == NULL) {
+        munmap(mapping, size);
+        return NULL;
+    }
+    float_mlp_set_activation_mode(mlp, (FloatActivationMode)h.activation_mode);
+
+    FloatCheckpoint *ckpt = (FloatCheckpoint *)malloc(sizeof(FloatCheckpoint));
+    if (ckpt == NULL) {
+        perror("Failed to allocate memory for FloatCheckpoint");
+        dealloc_float_mlp(mlp);
+        munmap(mapping, size);
+        return NULL;
+    }
+    ckpt->mlp = mlp;
+    ckpt->step = h.step;
+    ckpt->mapping = mapping;
+    ckpt->mapping_size = size;
+    return ckpt;
+}
+
+void float_checkpoint_close(FloatCheckpoint *ckpt) {
+    if (ckpt == NULL) return;
+    dealloc_float_mlp(ckpt->mlp);
+    munmap(ckpt->mapping, ckpt->mapping_size);
+    free(ckpt);
+}
+
+/* Rebuilds the saved optimizer, or NULL when its state vectors are not the ones the kind needs. */
+static FloatOptimizer* restore_optimizer(const CheckpointHeader *h, const char *mapping) {
+    size_t count = (size_t)h->parameter_count;
+    FloatOptimizer *opt = NULL;
+    switch ((FloatOptimizerKind)(h->optimizer - 1)) {
+        case FLOAT_OPTIM_SGD:
+            opt = float_optim_sgd(count, h->learning_rate, h->beta1);
+            break;
+        case FLOAT_OPTIM_RMSPROP:
+            opt = float_optim_rmsprop(count, h->learning_rate, h->beta2, h->epsilon);
+            break;
+        case FLOAT_OPTIM_ADAM:
+            opt = float_optim_adam(count, h->learning_rate, h->beta1, h->beta2, h->epsilon);
+            break;
+    }
+    if (opt == NULL) return NULL;
+    if ((opt->first != NULL) != (h->first_offset != 0) ||
+        (opt->second != NULL) != (h->second_offset != 0)) {
+        dealloc_float_optimizer(opt);
+        return NULL;
+    }
+    opt->step = h->step;
+    if (opt->first != NULL) {
+        memcpy(opt->first->data[0], mapping + h->first_offset, count * sizeof(double));
+    }
+    if (opt->second != NULL) {
+        memcpy(opt->second->data[0], mapping + h->second_offset, count * sizeof(double));
+    }
+    return opt;
+}
+
+/*
+ * Copies a checkpoint into a trainable network. With optimizer non-NULL
+ * the saved optimizer is rebuilt, set on the network and returned there
+ * for the caller to free (NULL when none was saved), so training resumes
+ * exactly where it stopped.
+ */
+FloatMLP* float_checkpoint_load(const char *path, size_t max_batch, FloatOptimizer **optimizer) {
+    if (optimizer != NULL) {
+        *optimizer = NULL;
+    }
+    FloatCheckpoint *ckpt = float_checkpoint_open(path, max_batch);
+    if (ckpt == NULL) return NULL;
+
+    CheckpointHeader h;
+    memcpy(&h, ckpt->mapping, sizeof(h));
+    FloatMLP *wrapped = ckpt->mlp;
+    size_t layers = wrapped->layer_count;
+    size_t *sizes = (size_t *)malloc((layers + 1) * sizeof(size_t));
+    FloatActivation *activations = (FloatActivation *)malloc(layers * sizeof(FloatActivation));
+    FloatMLP *mlp = NULL;
+    if (sizes == NULL || activations == NULL) {
+        perror("Failed to allocate memory for checkpoint");
+    } else {
+        sizes[0] = wrapped->layers[0].inputs;
+        for (size_t l = 0; l < layers; l++) {
+            sizes[l + 1] = wrapped->layers[l].outputs;
+            activations[l] = wrapped->layers[l].activation;
+        }
+        mlp = float_mlp_create(sizes, activations, layers, max_batch, 0);
+    }
+    if (mlp != NULL) {
+        memcpy(mlp->parameters->data[0], wrapped->parameters->data[0],
+               mlp->parameter_count * sizeof(double));
+        float_mlp_set_activation_mode(mlp, wrapped->activation_mode);
+        if (optimizer != NULL && h.optimizer != 0) {
+            *optimizer = restore_optimizer(&h, (const char *)ckpt->mapping);
+            if (*optimizer == NULL) {
+                printf("Corrupt optimizer state in checkpoint: %s\n", path);
+                dealloc_float_mlp(mlp);
+                mlp = NULL;
+            } else {
+                float_mlp_set_optimizer(mlp, *optimizer);
+            }
+        }
+    }
+    free(sizes);
+    free(activations);
+    float_checkpoint_close(ckpt);
+    return mlp;
+}
+
+/* Three-class toy problem: the class is the sign pattern of two of the four inputs. */
+static void checkpoint_data(double *X, double *Y, size_t samples) {
+    for (size_t i = 0; i < samples; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            X[i * 4 + j] = sin((double)(i * 4 + j) * 0.37);
+        }
+        size_t label = X[i * 4] > 0.0 ? (X[i * 4 + 1] > 0.0 ? 0 : 1) : 2;
+        for (size_t c = 0; c < 3; c++) {
+            Y[i * 3 + c] = c == label ? 1.0 : 0.0;
+        }
+    }
+}
+
+void test_float_checkpoint_roundtrip() {
+    printf("\n=== Testing Checkpoint Round Trip ===\n");
+
+    size_t sizes[4] = {4, 16, 8, 3};
+    FloatActivation activations[3] = {FLOAT_ACT_TANH, FLOAT_ACT_RELU, FLOAT_ACT_SOFTMAX};
+    size_t samples = 32;
+    double X[32 * 4], Y[32 * 3], expected[32 * 3];
+    checkpoint_data(X, Y, samples);
+
+    FloatMLP *mlp = float_mlp_create(sizes, activations, 3, samples, 7);
+    FloatOptimizer *adam = mlp == NULL ? NULL :
+        float_optim_adam(mlp->parameter_count, 0.01, FLOAT_OPTIM_ADAM_BETA1, FLOAT_OPTIM_ADAM_BETA2,
+                         FLOAT_OPTIM_EPSILON);
+    if (mlp == NULL || adam == NULL) {
+        dealloc_float_mlp(mlp);
+        dealloc_float_optimizer(adam);
+        return;
+    }
+    float_mlp_set_activation_mode(mlp, FLOAT_ACTIVATIONS_FAST);
+    float_mlp_set_optimizer(mlp, adam);
+    for (int i = 0; i < 20; i++) {
+        float_mlp_train_batch(mlp, X, Y, samples, 0.01);
+    }
+
+    const char *path = "checkpoint_roundtrip.fckpt";
+    if (float_checkpoint_save(path, mlp) != 0) {
+        dealloc_float_mlp(mlp);
+        dealloc_float_optimizer(adam);
+        return;
+    }
+    memcpy(expected, float_mlp_forward_batch(mlp, X, samples), sizeof(expected));
+
+    // Served straight from the mapping: same outputs, weights never copied
+    FloatCheckpoint *ckpt = float_checkpoint_open(path, samples);
+    if (ckpt != NULL) {
+        const char *weights = (const char *)ckpt->mlp->parameters->data[0];
+        const char *mapping = (const char *)ckpt->mapping;
+        int in_place = weights > mapping && weights < mapping + ckpt->mapping_size &&
+                       (uintptr_t)weights % FLOAT_CHECKPOINT_ALIGN == 0;
+        const double *out = float_mlp_forward_batch(ckpt->mlp, X, samples);
+        printf("Mapped weights used in place, page aligned: %s (expected: yes)\n", in_place ? "yes" : "no");
+        printf("Mapped outputs identical: %s (expected: yes)\n",
+               memcmp(out, expected, sizeof(expected)) == 0 ? "yes" : "no");
+        printf("Mapped network refuses training: %s (expected: yes)\n",
+               float_mlp_backward_batch(ckpt->mlp, X, Y, samples) < 0.0 ? "yes" : "no");
+        float_checkpoint_close(ckpt);
+    }
+
+    // Resumed training follows the original step for step
+    FloatOptimizer *restored = NULL;
+    FloatMLP *loaded = float_checkpoint_load(path, samples, &restored);
+    if (loaded != NULL && restored != NULL) {
+        printf("Optimizer step restored: %llu (expected: %llu)\n",
+               (unsigned long long)restored->step, (unsigned long long)adam->step);
+        for (int i = 0; i < 10; i++) {
+            float_mlp_train_batch(mlp, X, Y, samples, 0.01);
+            float_mlp_train_batch(loaded, X, Y, samples, 0.01);
+        }
+        double error = 0.0;
+        for (size_t i = 0; i < mlp->parameter_count; i++) {
+            double d = fabs(mlp->parameters->data[0][i] - loaded->parameters->data[0][i]);
+            if (d > error) error = d;
+        }
+        printf("Resumed vs uninterrupted training after 10 steps: %.2e (expected: 0)\n", error);
+    }
+    remove(path);
+
+    dealloc_float_mlp(loaded);
+    dealloc_float_optimizer(restored);
+    dealloc_float_mlp(mlp);
+    dealloc_float_optimizer(adam);
+}
+
+void test_float_checkpoint_corrupt() {
+    printf("\n=== Testing Checkpoint Validation ===\n");
+
+    size_t sizes[3] = {4, 8, 3};
+    FloatActivation activations[2] = {FLOAT_ACT_TANH, FLOAT_ACT_SOFTMAX};
+    FloatMLP *mlp = float_mlp_create(sizes, activations, 2, 4, 3);
+    if (mlp == NULL) return;
+
+    const char *path = "checkpoint_corrupt.fckpt";
+    int rejected = 0;
+    if (float_checkpoint_save(path, mlp) == 0) {
+        FloatCheckpoint *ckpt = float_checkpoint_open(path, 4);
+        printf("Valid checkpoint opens: %s (expected: yes)\n", ckpt != NULL ? "yes" : "no");
+        float_checkpoint_close(ckpt);
+
+        uint32_t version = FLOAT_CHECKPOINT_VERSION + 1;
+        FILE *file = fopen(path, "r+b");
+        if (file != NULL) {
+            fseek(file, 8, SEEK_SET);
+            fwrite(&version, sizeof(version), 1, file);
+            fclose(file);
+        }
+        rejected += float_checkpoint_open(path, 4) == NULL;
+
+        float_checkpoint_save(path, mlp);
+        struct stat st;
+        if (stat(path, &st) == 0 && truncate(path, st.st_size - FLOAT_CHECKPOINT_ALIGN) == 0) {
+            rejected += float_checkpoint_load(path, 4, NULL) == NULL;
+        }
+    }
+    printf("Bad version and truncated file rejected: %d of 2 (expected: 2)\n", rejected);
+    remove(path);
+    dealloc_float_mlp(mlp);
+}
+
+#ifndef NO_CHECKPOINT_MAIN
+int main() {
+    printf("Checkpoint Test\n");
+    printf("===============\n");
+
+    test_float_checkpoint_roundtrip();
+    test_float_checkpoint_corrupt();
+
+    printf("\n✓ All checkpoint tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,46 @@
+#ifndef FLOAT_CHECKPOINT_H
+#define FLOAT_CHECKPOINT_H
+
+#include "float_mlp.h"
+#include "float_optim.h"
+
+/*
+ * Binary FloatMLP checkpoints (POSIX: mmap).
+ *
+ * A checkpoint is a header (magic, version, byte-order marker, optimizer
+ * hyper-parameters and the offsets below) followed by the layer sizes and
+ * activations as uint64 tables, then the tensors, each starting on a
+ * FLOAT_CHECKPOINT_ALIGN byte boundary:
+ *   - the parameter block, exactly as FloatMLP keeps it in memory,
+ *   - the optimizer's first and second state vectors, when present.
+ * All fields are in the writer's byte order; other machines reject the
+ * file rather than swapping it.
+ *
+ * float_checkpoint_open maps the file and wraps an inference-only network
+ * around the parameter block in place, so opening costs a header check and
+ * the weights are paged in by the first forward passes. The mapping is
+ * private: processes serving the same file share its page cache, and
+ * nothing written through the network reaches the file.
+ * float_checkpoint_load copies everything into a trainable network and
+ * optimizer to resume training.
+ */
+#define FLOAT_CHECKPOINT_MAGIC "FCHKPT01"
+#define FLOAT_CHECKPOINT_VERSION 1
+#define FLOAT_CHECKPOINT_ALIGN 4096
+
+typedef struct FloatCheckpoint {
+    FloatMLP *mlp;       // Inference-only, weights inside the mapping
+    uint64_t step;       // Optimizer updates made before the save
+    void *mapping;
+    size_t mapping_size;
+} FloatCheckpoint;
+
+int float_checkpoint_save(const char *path, FloatMLP *mlp);
+FloatCheckpoint* float_checkpoint_open(const char *path, size_t max_batch);
+void float_checkpoint_close(FloatCheckpoint *ckpt);
+FloatMLP* float_checkpoint_load(const char *path, size_t max_batch, FloatOptimizer **optimizer);
+
+void test_float_checkpoint_roundtrip(void);
+void test_float_checkpoint_corrupt(void);
+
+#endif
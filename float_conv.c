@@ -0,0 +1,402 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_optim.h"
+#include "float_conv.h"
+#include "matrix_random.h"
+
+size_t float_conv1d_output_length(const FloatConv1D *conv, size_t length) {
+    size_t span = conv->dilation * (conv->kernel - 1) + 1;
+    if (length + 2 * conv->padding < span) {
+        return 0;
+    }
+    return (length + 2 * conv->padding - span) / conv->stride + 1;
+}
+
+/*
+ * Kernel taps, stride and dilation must be positive. Series of up to
+ * max_length steps can be run max_series at a time. Weights get He
+ * initialisation over the kernel * in_channels fan-in; the bias starts at
+ * zero.
+ */
+FloatConv1D* float_conv1d_create(size_t in_channels, size_t out_channels, size_t kernel,
+                                 size_t stride, size_t dilation, size_t padding,
+                                 size_t max_series, size_t max_length, uint64_t seed) {
+    if (in_channels == 0 || out_channels == 0 || kernel == 0 || stride == 0 || dilation == 0 ||
+        max_series == 0 || max_length == 0) {
+        printf("Convolution sizes, stride and dilation must be positive\n");
+        return NULL;
+    }
+    FloatConv1D *conv = (FloatConv1D *)calloc(1, sizeof(FloatConv1D));
+    if (conv == NULL) {
+        perror("Failed to allocate memory for FloatConv1D");
+        return NULL;
+    }
+    conv->in_channels = in_channels;
+    conv->out_channels = out_channels;
+    conv->kernel = kernel;
+    conv->stride = stride;
+    conv->dilation = dilation;
+    conv->padding = padding;
+    conv->max_series = max_series;
+    conv->max_length = max_length;
+    conv->algorithm = FLOAT_CONV_AUTO;
+    size_t max_out = float_conv1d_output_length(conv, max_length);
+    if (max_out == 0) {
+        printf("A %zu-step series is shorter than the %zu-tap filter's span\n", max_length, kernel);
+        free(conv);
+        return NULL;
+    }
+
+    size_t field = kernel * in_channels;
+    size_t bias_offset = float_optim_padded_length(field * out_channels);
+    conv->parameter_count = bias_offset + float_optim_padded_length(out_channels);
+    conv->parameters = create_float_matrix(1, conv->parameter_count);
+    conv->gradients = create_float_matrix(1, conv->parameter_count);
+    conv->columns = create_float_matrix(max_series * max_out, field);
+    if (conv->parameters == NULL || conv->gradients == NULL || conv->columns == NULL) {
+        dealloc_float_conv1d(conv);
+        return NULL;
+    }
+    init_float_zero(conv->parameters);
+    init_float_zero(conv->gradients);
+    conv->weights = float_matrix_view(conv->parameters->data[0], field, out_channels);
+    conv->bias = float_matrix_view(conv->parameters->data[0] + bias_offset, 1, out_channels);
+    conv->weight_grad = float_matrix_view(conv->gradients->data[0], field, out_channels);
+    conv->bias_grad = float_matrix_view(conv->gradients->data[0] + bias_offset, 1, out_channels);
+    if (conv->weights == NULL || conv->bias == NULL || conv->weight_grad == NULL ||
+        conv->bias_grad == NULL) {
+        dealloc_float_conv1d(conv);
+        return NULL;
+    }
+    float_init_he(conv->weights, seed);
+    return conv;
+}
+
+void dealloc_float_conv1d(FloatConv1D *conv) {
+    if (conv == NULL) return;
+    dealloc_float_matrix(conv->weights);
+    dealloc_float_matrix(conv->bias);
+    dealloc_float_matrix(conv->weight_grad);
+    dealloc_float_matrix(conv->bias_grad);
+    dealloc_float_matrix(conv->parameters);
+    dealloc_float_matrix(conv->gradients);
+    dealloc_float_matrix(conv->columns);
+    free(conv);
+}
+
+/* Same contract as float_mlp_set_optimizer. */
+int float_conv1d_set_optimizer(FloatConv1D *conv, FloatOptimizer *optimizer) {
+    if (float_optim_fits(optimizer, conv->parameter_count) != 0) {
+        return -1;
+    }
+    conv->optimizer = optimizer;
+    return 0;
+}
+
+/* Returns the series length, or 0 when input does not fit the layer. */
+static size_t check_input(const FloatConv1D *conv, const FloatMatrix *input, size_t series) {
+    if (series == 0 || series > conv->max_series || input->cols != conv->in_channels ||
+        input->rows % series != 0) {
+        printf("Input is %zu x %zu; expected %zu series (at most %zu) of %zu channels\n",
+               input->rows, input->cols, series, conv->max_series, conv->in_channels);
+        return 0;
+    }
+    size_t length = input->rows / series;
+    if (length > conv->max_length || float_conv1d_output_length(conv, length) == 0) {
+        printf("Series of %zu steps do not fit the layer (max %zu)\n", length, conv->max_length);
+        return 0;
+    }
+    return length;
+}
+
+/* Gathers every receptive field into a row of the columns buffer; padding reads as zero. */
+static void im2col(FloatConv1D *conv, const double *x, size_t series, size_t length, size_t out_length) {
+    size_t C = conv->in_channels, field = conv->kernel * C;
+    long rows = (long)(series * out_length);
+    double *columns = conv->columns->data[0];
+    int parallel = (double)rows * (double)field >= float_tuning()->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long r = 0; r < rows; r++) {
+        size_t s = (size_t)r / out_length, t = (size_t)r % out_length;
+        double *row = columns + (size_t)r * field;
+        for (size_t k = 0; k < conv->kernel; k++) {
+            long step = (long)(t * conv->stride + k * conv->dilation) - (long)conv->padding;
+            if (step < 0 || step >= (long)length) {
+                memset(row + k * C, 0, C * sizeof(double));
+            } else {
+                memcpy(row + k * C, x + (s * length + (size_t)step) * C, C * sizeof(double));
+            }
+        }
+    }
+}
+
+/*
+ * The direct form of the same product: each output row starts as the bias
+ * and accumulates tap k of every input channel times its row of weights.
+ */
+static void direct_forward(FloatConv1D *conv, const double *x, double *y, size_t series,
+                           size_t length, size_t out_length) {
+    size_t C = conv->in_channels, N = conv->out_channels;
+    long rows = (long)(series * out_length);
+    const double *W = conv->weights->data[0];
+    const double *bias = conv->bias->data[0];
+    int parallel = (double)rows * (double)(conv->kernel * C * N) >= float_tuning()->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long r = 0; r < rows; r++) {
+        size_t s = (size_t)r / out_length, t = (size_t)r % out_length;
+        double *y_row = y + (size_t)r * N;
+        memcpy(y_row, bias, N * sizeof(double));
+        for (size_t k = 0; k < conv->kernel; k++) {
+            long step = (long)(t * conv->stride + k * conv->dilation) - (long)conv->padding;
+            if (step < 0 || step >= (long)length) continue;
+            const double *x_row = x + (s * length + (size_t)step) * C;
+            for (size_t c = 0; c < C; c++) {
+                double a = x_row[c];
+                const double *w_row = W + (k * C + c) * N;
+                #pragma omp simd
+                for (size_t j = 0; j < N; j++) {
+                    y_row[j] += a * w_row[j];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Convolves all series of input in one call: output receives
+ * (series * L_out) x out_channels. Returns -1 on a shape error.
+ */
+int float_conv1d_forward(FloatConv1D *conv, FloatMatrix *input, size_t series, FloatMatrix *output) {
+    size_t length = check_input(conv, input, series);
+    if (length == 0) {
+        return -1;
+    }
+    size_t out_length = float_conv1d_output_length(conv, length);
+    size_t rows = series * out_length, field = conv->kernel * conv->in_channels;
+    size_t N = conv->out_channels;
+    if (output->rows != rows || output->cols != N) {
+        printf("Convolution output must be %zu x %zu\n", rows, N);
+        return -1;
+    }
+    if (float_make_writable(output) != 0) {
+        return -1;
+    }
+    const double *x = input->data[0];
+    double *y = output->data[0];
+
+    FloatConvAlgorithm algorithm = conv->algorithm;
+    if (algorithm == FLOAT_CONV_AUTO) {
+        algorithm = (field <= FLOAT_CONV_DIRECT_MAX_FIELD) ? FLOAT_CONV_DIRECT : FLOAT_CONV_IM2COL;
+    }
+    if (algorithm == FLOAT_CONV_DIRECT) {
+        direct_forward(conv, x, y, series, length, out_length);
+        return 0;
+    }
+
+    im2col(conv, x, series, length, out_length);
+    const double *bias = conv->bias->data[0];
+    for (size_t r = 0; r < rows; r++) {
+        memcpy(y + r * N, bias, N * sizeof(double));
+    }
+    float_gemm_kernel(rows, N, field, 1.0, conv->columns->data[0], field,
+                      conv->weights->data[0], N, y, N);
+    return 0;
+}
+
+/*
+ * Given dLoss/d output for the batch the last forward call ran on (input
+ * must be the same), replaces the weight and bias gradients and, when
+ * d_input is not NULL, writes dLoss/d input into it (same shape as input).
+ * Returns -1 on a shape error.
+ */
+int float_conv1d_backward(FloatConv1D *conv, FloatMatrix *input, size_t series, FloatMatrix *d_output,
+                          FloatMatrix *d_input) {
+    size_t length = check_input(conv, input, series);
+    if (length == 0) {
+        return -1;
+    }
+    size_t out_length = float_conv1d_output_length(conv, length);
+    size_t rows = series * out_length, field = conv->kernel * conv->in_channels;
+    size_t C = conv->in_channels, N = conv->out_channels;
+    if (d_output->rows != rows || d_output->cols != N) {
+        printf("Output gradient must be %zu x %zu\n", rows, N);
+        return -1;
+    }
+    if (d_input != NULL && (d_input->rows != input->rows || d_input->cols != C)) {
+        printf("Input gradient must be %zu x %zu\n", input->rows, C);
+        return -1;
+    }
+    if (d_input != NULL && float_make_writable(d_input) != 0) {
+        return -1;
+    }
+    const double *dy = d_output->data[0];
+    double *columns = conv->columns->data[0];
+
+    // dW = columns^T dY, db = column sums of dY
+    im2col(conv, input->data[0], series, length, out_length);
+    memset(conv->gradients->data[0], 0, conv->parameter_count * sizeof(double));
+    float_gemm_kernel_tn(field, N, rows, 1.0, columns, field, dy, N,
+                         conv->weight_grad->data[0], N);
+    double *bias_grad = conv->bias_grad->data[0];
+    for (size_t r = 0; r < rows; r++) {
+        const double *dy_row = dy + r * N;
+        #pragma omp simd
+        for (size_t j = 0; j < N; j++) {
+            bias_grad[j] += dy_row[j];
+        }
+    }
+    if (d_input == NULL) {
+        return 0;
+    }
+
+    // d columns = dY W^T, then scatter-added back onto the steps they were
+    // gathered from; series are disjoint, so each thread takes whole series
+    memset(columns, 0, rows * field * sizeof(double));
+    float_gemm_kernel_nt(rows, field, N, 1.0, dy, N, conv->weights->data[0], N, columns, field);
+    double *dx = d_input->data[0];
+    memset(dx, 0, input->rows * C * sizeof(double));
+    int parallel = (double)rows * (double)field >= float_tuning()->parallel_threshold;
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long s = 0; s < (long)series; s++) {
+        for (size_t t = 0; t < out_length; t++) {
+            const double *row = columns + ((size_t)s * out_length + t) * field;
+            for (size_t k = 0; k < conv->kernel; k++) {
+                long step = (long)(t * conv->stride + k * conv->dilation) - (long)conv->padding;
+                if (step < 0 || step >= (long)length) continue;
+                double *dx_row = dx + ((size_t)s * length + (size_t)step) * C;
+                #pragma omp simd
+                for (size_t c = 0; c < C; c++) {
+                    dx_row[c] += row[k * C + c];
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* Applies the gradients through the layer's optimizer, or plain SGD without one. */
+void float_conv1d_update(FloatConv1D *conv, double learning_rate) {
+    float_optim_apply(conv->optimizer, conv->parameters->data[0], conv->gradients->data[0],
+                      conv->parameter_count, learning_rate);
+}
+
+/* 0.5 * sum((y - target)^2) of a forward pass. */
+static double conv_loss(FloatConv1D *conv, FloatMatrix *x, size_t series, FloatMatrix *y,
+                        const FloatMatrix *target) {
+    float_conv1d_forward(conv, x, series, y);
+    double loss = 0.0;
+    for (size_t i = 0; i < y->rows; i++) {
+        for (size_t j = 0; j < y->cols; j++) {
+            double error = y->data[i][j] - target->data[i][j];
+            loss += 0.5 * error * error;
+        }
+    }
+    return loss;
+}
+
+void test_float_conv1d() {
+    printf("\n=== Testing Conv1D ===\n");
+
+    // 3 series of 11 steps, 5 channels -> 4 channels; 3 taps, stride 2, dilation 2, padding 3
+    size_t series = 3, length = 11, C = 5, N = 4;
+    FloatConv1D *conv = float_conv1d_create(C, N, 3, 2, 2, 3, series, length, 17);
+    if (conv == NULL) return;
+    size_t out_length = float_conv1d_output_length(conv, length);
+    FloatMatrix *x = create_float_matrix(series * length, C);
+    FloatMatrix *y = create_float_matrix(series * out_length, N);
+    FloatMatrix *direct = create_float_matrix(series * out_length, N);
+    FloatMatrix *target = create_float_matrix(series * out_length, N);
+    FloatMatrix *dy = create_float_matrix(series * out_length, N);
+    FloatMatrix *dx = create_float_matrix(series * length, C);
+    if (x == NULL || y == NULL || direct == NULL || target == NULL || dy == NULL || dx == NULL) {
+        dealloc_float_matrix(x);
+        dealloc_float_matrix(y);
+        dealloc_float_matrix(direct);
+        dealloc_float_matrix(target);
+        dealloc_float_matrix(dy);
+        dealloc_float_matrix(dx);
+        dealloc_float_conv1d(conv);
+        return;
+    }
+    float_fill_uniform(x, -1.0, 1.0, 3);
+    float_fill_uniform(target, -1.0, 1.0, 4);
+    float_fill_uniform(conv->bias, -0.5, 0.5, 5);
+    printf("Output length: %zu (expected: 7)\n", out_length);
+
+    // Both algorithms against the definition, tap by tap
+    conv->algorithm = FLOAT_CONV_IM2COL;
+    float_conv1d_forward(conv, x, series, y);
+    conv->algorithm = FLOAT_CONV_DIRECT;
+    float_conv1d_forward(conv, x, series, direct);
+    double im2col_error = 0.0, direct_error = 0.0;
+    for (size_t s = 0; s < series; s++) {
+        for (size_t t = 0; t < out_length; t++) {
+            for (size_t j = 0; j < N; j++) {
+                double expected = conv->bias->data[0][j];
+                for (size_t k = 0; k < 3; k++) {
+                    long step = (long)(2 * t + 2 * k) - 3;
+                    if (step < 0 || step >= (long)length) continue;
+                    for (size_t c = 0; c < C; c++) {
+                        expected += x->data[s * length + (size_t)step][c] * conv->weights->data[k * C + c][j];
+                    }
+                }
+                size_t r = s * out_length + t;
+                if (fabs(y->data[r][j] - expected) > im2col_error) im2col_error = fabs(y->data[r][j] - expected);
+                if (fabs(direct->data[r][j] - expected) > direct_error) direct_error = fabs(direct->data[r][j] - expected);
+            }
+        }
+    }
+    printf("im2col / direct vs definition: %.2e / %.2e (expected: < 1e-14)\n", im2col_error, direct_error);
+
+    // Central differences on every weight, bias and input value
+    conv->algorithm = FLOAT_CONV_IM2COL;
+    float_conv1d_forward(conv, x, series, y);
+    for (size_t i = 0; i < y->rows; i++) {
+        for (size_t j = 0; j < N; j++) {
+            dy->data[i][j] = y->data[i][j] - target->data[i][j];
+        }
+    }
+    float_conv1d_backward(conv, x, series, dy, dx);
+    double h = 1e-6, worst = 0.0;
+    size_t x_count = series * length * C;
+    for (size_t i = 0; i < conv->parameter_count + x_count; i++) {
+        double *value = (i < conv->parameter_count) ? &conv->parameters->data[0][i]
+                                                    : &x->data[0][i - conv->parameter_count];
+        double analytic = (i < conv->parameter_count) ? conv->gradients->data[0][i]
+                                                      : dx->data[0][i - conv->parameter_count];
+        double saved = *value;
+        *value = saved + h;
+        double up = conv_loss(conv, x, series, y, target);
+        *value = saved - h;
+        double down = conv_loss(conv, x, series, y, target);
+        *value = saved;
+        double error = fabs((up - down) / (2.0 * h) - analytic);
+        if (error > worst) worst = error;
+    }
+    printf("Gradient error vs finite differences: %.2e (expected: < 1e-8)\n", worst);
+
+    dealloc_float_matrix(x);
+    dealloc_float_matrix(y);
+    dealloc_float_matrix(direct);
+    dealloc_float_matrix(target);
+    dealloc_float_matrix(dy);
+    dealloc_float_matrix(dx);
+    dealloc_float_conv1d(conv);
+}
+
+#ifndef NO_CONV_MAIN
+int main() {
+    printf("Conv1D Test\n");
+    printf("===========\n");
+
+    test_float_conv1d();
+
+    printf("\n✓ All Conv1D tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,72 @@
+#ifndef FLOAT_CONV_H
+#define FLOAT_CONV_H
+
+#include <stdint.h>
+#include "float_matrix.h"
+#include "float_optim.h"
+
+/*
+ * IM2COL gathers every receptive field into a row of the columns buffer
+ * and runs one blocked GEMM; DIRECT accumulates straight from the input
+ * rows and suits filters with few taps. AUTO picks DIRECT when a
+ * receptive field (kernel x in_channels) is at most
+ * FLOAT_CONV_DIRECT_MAX_FIELD values. The backward pass always uses the
+ * columns buffer.
+ */
+typedef enum FloatConvAlgorithm {
+    FLOAT_CONV_AUTO,
+    FLOAT_CONV_IM2COL,
+    FLOAT_CONV_DIRECT
+} FloatConvAlgorithm;
+
+#define FLOAT_CONV_DIRECT_MAX_FIELD 16
+
+/*
+ * 1D convolution over a batch of series. A batch of S series of length L
+ * is an (S * L) x in_channels FloatMatrix, series after series, one time
+ * step per row (the days x OHLCV layout of the stock files). The output
+ * is (S * L_out) x out_channels with
+ *   L_out = (L + 2 padding - dilation (kernel - 1) - 1) / stride + 1
+ * and output step t of a series reads input steps
+ * t stride - padding + k dilation for k < kernel, zeros outside 0..L-1.
+ *
+ * weights is (kernel * in_channels) x out_channels, row k * in_channels + c
+ * holding tap k of input channel c; weights and bias live in one
+ * parameter block as in FloatMLP. columns is sized at creation for
+ * max_series series of max_length steps.
+ */
+typedef struct FloatConv1D {
+    size_t in_channels;
+    size_t out_channels;
+    size_t kernel;
+    size_t stride;
+    size_t dilation;
+    size_t padding;
+    size_t max_series;
+    size_t max_length;
+    FloatConvAlgorithm algorithm;
+    size_t parameter_count;
+    FloatMatrix *parameters;
+    FloatMatrix *gradients;
+    FloatMatrix *weights;
+    FloatMatrix *bias;
+    FloatMatrix *weight_grad;
+    FloatMatrix *bias_grad;
+    FloatMatrix *columns;
+    FloatOptimizer *optimizer;
+} FloatConv1D;
+
+FloatConv1D* float_conv1d_create(size_t in_channels, size_t out_channels, size_t kernel,
+                                 size_t stride, size_t dilation, size_t padding,
+                                 size_t max_series, size_t max_length, uint64_t seed);
+void dealloc_float_conv1d(FloatConv1D *conv);
+size_t float_conv1d_output_length(const FloatConv1D *conv, size_t length);
+int float_conv1d_forward(FloatConv1D *conv, FloatMatrix *input, size_t series, FloatMatrix *output);
+int float_conv1d_backward(FloatConv1D *conv, FloatMatrix *input, size_t series, FloatMatrix *d_output,
+                          FloatMatrix *d_input);
+int float_conv1d_set_optimizer(FloatConv1D *conv, FloatOptimizer *optimizer);
+void float_conv1d_update(FloatConv1D *conv, double learning_rate);
+
+void test_float_conv1d(void);
+
+#endif
@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_mlp.h"
+#include "float_optim.h"
+#include "float_dp.h"
+#include "matrix_random.h"
+
+/*
+ * workers replicas, each sized for its share of the model's largest
+ * batch. reduction picks how their gradients are summed in the
+ * synchronous calls; the Hogwild epoch ignores it.
+ */
+FloatDataParallel* float_dp_create(FloatMLP *model, int workers, FloatReduction reduction) {
+    if (workers < 1) {
+        printf("Data-parallel training needs at least one worker\n");
+        return NULL;
+    }
+    if (model->gradients == NULL) {
+        printf("This network is inference-only\n");
+        return NULL;
+    }
+    FloatDataParallel *dp = (FloatDataParallel *)malloc(sizeof(FloatDataParallel));
+    if (dp == NULL) {
+        perror("Failed to allocate memory for FloatDataParallel");
+        return NULL;
+    }
+    dp->model = model;
+    dp->workers = workers;
+    dp->reduction = reduction;
+    dp->replicas = (FloatMLP **)calloc((size_t)workers, sizeof(FloatMLP *));
+    if (dp->replicas == NULL) {
+        perror("Failed to allocate memory for replicas");
+        free(dp);
+        return NULL;
+    }
+    size_t shard = (model->max_batch + (size_t)workers - 1) / (size_t)workers;
+    for (int w = 0; w < workers; w++) {
+        dp->replicas[w] = float_mlp_replica(model, shard);
+        if (dp->replicas[w] == NULL) {
+            dealloc_float_dp(dp);
+            return NULL;
+        }
+    }
+    return dp;
+}
+
+void dealloc_float_dp(FloatDataParallel *dp) {
+    if (dp == NULL) return;
+    for (int w = 0; w < dp->workers; w++) {
+        dealloc_float_mlp(dp->replicas[w]);
+    }
+    free(dp->replicas);
+    free(dp);
+}
+
+/*
+ * Forward and backward pass for rows lo..hi of a batch on one replica.
+ * The rows are read in place from inputs/targets, or gathered into the
+ * replica's staging buffers through order when it is not NULL. Returns
+ * the shard's summed loss; an empty shard leaves zero gradients.
+ */
+static double shard_backward(FloatMLP *replica, const double *inputs, const double *targets,
+                             FloatMatrix *X, FloatMatrix *Y, const size_t *order,
+                             size_t lo, size_t hi) {
+    size_t in = replica->layers[0].inputs;
+    size_t out = replica->layers[replica->layer_count - 1].outputs;
+    if (hi == lo) {
+        memset(replica->gradients->data[0], 0, replica->parameter_count * sizeof(double));
+        return 0.0;
+    }
+    if (order != NULL) {
+        for (size_t r = lo; r < hi; r++) {
+            memcpy(replica->batch_input->data[r - lo], X->data[order[r]], in * sizeof(double));
+            memcpy(replica->batch_target->data[r - lo], Y->data[order[r]], out * sizeof(double));
+        }
+        inputs = replica->batch_input->data[0];
+        targets = replica->batch_target->data[0];
+    } else {
+        inputs += lo * in;
+        targets += lo * out;
+    }
+    return float_mlp_backward_batch(replica, inputs, targets, hi - lo) * (double)(hi - lo);
+}
+
+/* Sums the replicas' gradients into the model's gradient block. */
+static void reduce_gradients(FloatDataParallel *dp) {
+    int workers = dp->workers;
+    long count = (long)dp->model->parameter_count;
+    double *total = dp->model->gradients->data[0];
+    FloatMLP **replicas = dp->replicas;
+
+    if (dp->reduction == FLOAT_REDUCE_RING) {
+        // Thread c owns chunk c and walks the replicas starting from c + 1
+        long chunk = ((count + workers - 1) / workers + 7) & ~7L;
+        #pragma omp parallel for schedule(static, 1) num_threads(workers)
+        for (int c = 0; c < workers; c++) {
+            long lo = (long)c * chunk;
+            long hi = (lo + chunk < count) ? lo + chunk : count;
+            if (lo >= hi) continue;
+            const double *first = replicas[(c + 1) % workers]->gradients->data[0];
+            memcpy(total + lo, first + lo, (size_t)(hi - lo) * sizeof(double));
+            for (int k = 2; k <= workers; k++) {
+                const double *g = replicas[(c + k) % workers]->gradients->data[0];
+                #pragma omp simd
+                for (long i = lo; i < hi; i++) {
+                    total[i] += g[i];
+                }
+            }
+        }
+        return;
+    }
+
+    // Tree: round s adds replica w + s into w for every w divisible by 2s;
+    // the last round writes its sum straight into the model
+    if (workers == 1) {
+        memcpy(total, replicas[0]->gradients->data[0], (size_t)count * sizeof(double));
+        return;
+    }
+    #pragma omp parallel num_threads(workers)
+    for (int stride = 1; stride < workers; stride *= 2) {
+        for (int w = 0; w + stride < workers; w += 2 * stride) {
+            double *a = replicas[w]->gradients->data[0];
+            const double *b = replicas[w + stride]->gradients->data[0];
+            double *sum = (w == 0 && 2 * stride >= workers) ? total : a;
+            #pragma omp for simd schedule(static)
+            for (long i = 0; i < count; i++) {
+                sum[i] = a[i] + b[i];
+            }
+        }
+    }
+}
+
+/* The synchronous step: shard, backward on every worker, reduce, update. */
+static double parallel_step(FloatDataParallel *dp, const double *inputs, const double *targets,
+                            FloatMatrix *X, FloatMatrix *Y, const size_t *order, size_t batch,
+                            double learning_rate) {
+    int workers = dp->workers;
+    double scale = 1.0 / (double)batch;
+    double loss = 0.0;
+    int failed = 0;
+
+    // Every replica's mean gradient is weighted by its share of the batch
+    #pragma omp parallel for schedule(static, 1) num_threads(workers) reduction(+:loss, failed)
+    for (int w = 0; w < workers; w++) {
+        FloatMLP *replica = dp->replicas[w];
+        size_t lo = batch * (size_t)w / (size_t)workers;
+        size_t hi = batch * (size_t)(w + 1) / (size_t)workers;
+        double shard_loss = shard_backward(replica, inputs, targets, X, Y, order, lo, hi);
+        if (shard_loss < 0.0) {
+            failed++;
+            continue;
+        }
+        double weight = (double)(hi - lo) * scale;
+        double *g = replica->gradients->data[0];
+        #pragma omp simd
+        for (size_t i = 0; i < replica->parameter_count; i++) {
+            g[i] *= weight;
+        }
+        loss += shard_loss * scale;
+    }
+    if (failed) {
+        return -1.0;
+    }
+
+    reduce_gradients(dp);
+    float_mlp_update(dp->model, learning_rate);
+    return loss;
+}
+
+/*
+ * One synchronous step on batch contiguous rows: the result matches
+ * float_mlp_train_batch on the model up to the order of the gradient sums.
+ * Returns the mean loss, or -1 on a bad batch size.
+ */
+double float_dp_train_batch(FloatDataParallel *dp, const double *inputs, const double *targets,
+                            size_t batch, double learning_rate) {
+    if (batch == 0 || batch > dp->model->max_batch) {
+        printf("Batch size %zu is outside 1..%zu\n", batch, dp->model->max_batch);
+        return -1.0;
+    }
+    return parallel_step(dp, inputs, targets, NULL, NULL, NULL, batch, learning_rate);
+}
+
+static int check_epoch(FloatMLP *model, FloatMatrix *X, FloatMatrix *Y, size_t batch_size) {
+    size_t in = model->layers[0].inputs;
+    size_t out = model->layers[model->layer_count - 1].outputs;
+    if (X->cols != in || Y->cols != out || Y->rows != X->rows) {
+        printf("Training data does not match the network: X is %zu x %zu, Y is %zu x %zu\n",
+               X->rows, X->cols, Y->rows, Y->cols);
+        return -1;
+    }
+    if (batch_size == 0 || batch_size > model->max_batch) {
+        printf("Batch size %zu is outside 1..%zu\n", batch_size, model->max_batch);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * float_mlp_train_epoch with every mini-batch split across the workers.
+ * Given the same shuffle state it visits the same batches in the same
+ * order, so it trains the same network as the single-threaded call.
+ */
+double float_dp_train_epoch(FloatDataParallel *dp, FloatMatrix *X, FloatMatrix *Y, size_t batch_size,
+                            double learning_rate, MatrixRng *shuffle) {
+    FloatMLP *model = dp->model;
+    size_t samples = X->rows;
+    if (check_epoch(model, X, Y, batch_size) != 0) {
+        return -1.0;
+    }
+    if (shuffle != NULL && float_mlp_shuffle(model, samples, shuffle) != 0) {
+        return -1.0;
+    }
+
+    double total = 0.0;
+    for (size_t first = 0; first < samples; first += batch_size) {
+        size_t batch = (samples - first < batch_size) ? samples - first : batch_size;
+        double loss;
+        if (shuffle != NULL) {
+            loss = parallel_step(dp, NULL, NULL, X, Y, model->order + first, batch, learning_rate);
+        } else {
+            loss = parallel_step(dp, X->data[first], Y->data[first], NULL, NULL, NULL, batch,
+                                 learning_rate);
+        }
+        total += loss * (double)batch;
+    }
+    return total / (double)samples;
+}
+
+/*
+ * Asynchronous epoch: worker w takes the w-th slice of the (shuffled) rows
+ * and runs its own mini-batches of batch_size / workers rows, applying
+ * plain SGD to the shared weights after each one with no locks (Hogwild).
+ * Workers read weights another worker is updating and an update can
+ * overwrite a concurrent one; SGD tolerates both, and nothing waits on a
+ * reduction. The model's optimizer is not used, since its state would be
+ * raced on as well. Returns the mean loss over the epoch.
+ */
+double float_dp_train_epoch_hogwild(FloatDataParallel *dp, FloatMatrix *X, FloatMatrix *Y,
+                                    size_t batch_size, double learning_rate, MatrixRng *shuffle) {
+    FloatMLP *model = dp->model;
+    int workers = dp->workers;
+    size_t samples = X->rows;
+    if (check_epoch(model, X, Y, batch_size) != 0) {
+        return -1.0;
+    }
+    if (shuffle != NULL && float_mlp_shuffle(model, samples, shuffle) != 0) {
+        return -1.0;
+    }
+    size_t shard = (batch_size + (size_t)workers - 1) / (size_t)workers;
+    const size_t *order = (shuffle != NULL) ? model->order : NULL;
+    double *params = model->parameters->data[0];
+    double total = 0.0;
+
+    #pragma omp parallel for schedule(static, 1) num_threads(workers) reduction(+:total)
+    for (int w = 0; w < workers; w++) {
+        FloatMLP *replica = dp->replicas[w];
+        const double *g = replica->gradients->data[0];
+        size_t end = samples * (size_t)(w + 1) / (size_t)workers;
+        for (size_t lo = samples * (size_t)w / (size_t)workers; lo < end; lo += shard) {
+            size_t hi = (end - lo < shard) ? end : lo + shard;
+            double loss = shard_backward(replica, X->data[0], Y->data[0], X, Y, order, lo, hi);
+            if (loss < 0.0) break;
+            total += loss;
+            #pragma omp simd
+            for (size_t i = 0; i < replica->parameter_count; i++) {
+                params[i] -= learning_rate * g[i];
+            }
+        }
+    }
+    return total / (double)samples;
+}
+
+/* 0.5 * squared error per sample, averaged, for the model on all of X. */
+static double dataset_loss(FloatMLP *mlp, FloatMatrix *X, FloatMatrix *Y) {
+    double loss = 0.0;
+    for (size_t first = 0; first < X->rows; first += mlp->max_batch) {
+        size_t batch = (X->rows - first < mlp->max_batch) ? X->rows - first : mlp->max_batch;
+        const double *output = float_mlp_forward_batch(mlp, X->data[first], batch);
+        for (size_t j = 0; j < batch * Y->cols; j++) {
+            double error = output[j] - Y->data[first][j];
+            loss += 0.5 * error * error;
+        }
+    }
+    return loss / (double)X->rows;
+}
+
+static double max_parameter_difference(FloatMLP *a, FloatMLP *b) {
+    double worst = 0.0;
+    for (size_t i = 0; i < a->parameter_count; i++) {
+        double difference = fabs(a->parameters->data[0][i] - b->parameters->data[0][i]);
+        if (difference > worst) worst = difference;
+    }
+    return worst;
+}
+
+void test_float_data_parallel() {
+    printf("\n=== Testing Data-Parallel Training ===\n");
+
+    size_t samples = 96;
+    size_t sizes[3] = {4, 16, 2};
+    FloatActivation activations[2] = {FLOAT_ACT_TANH, FLOAT_ACT_LINEAR};
+    FloatMatrix *X = create_float_matrix(samples, 4);
+    FloatMatrix *Y = create_float_matrix(samples, 2);
+    if (X == NULL || Y == NULL) {
+        dealloc_float_matrix(X);
+        dealloc_float_matrix(Y);
+        return;
+    }
+    float_fill_uniform(X, -1.0, 1.0, 21);
+    for (size_t i = 0; i < samples; i++) {
+        const double *x = X->data[i];
+        Y->data[i][0] = sin(x[0] + x[1]) * 0.5;
+        Y->data[i][1] = x[2] * x[3] - 0.25 * x[0];
+    }
+
+    // The synchronous trainer must follow the single-threaded run exactly,
+    // with an uneven 3-way split (batches of 10, last batch 6) and a 4-way one
+    FloatReduction reductions[2] = {FLOAT_REDUCE_TREE, FLOAT_REDUCE_RING};
+    const char *names[2] = {"tree", "ring"};
+    for (int r = 0; r < 2; r++) {
+        for (int workers = 3; workers <= 4; workers++) {
+            FloatMLP *reference = float_mlp_create(sizes, activations, 2, 10, 5);
+            FloatMLP *model = float_mlp_create(sizes, activations, 2, 10, 5);
+            FloatDataParallel *dp = (model != NULL) ? float_dp_create(model, workers, reductions[r]) : NULL;
+            FloatOptimizer *reference_adam = NULL, *adam = NULL;
+            if (reference != NULL && dp != NULL && workers == 4) {
+                reference_adam = float_optim_adam(reference->parameter_count, 0.01, FLOAT_OPTIM_ADAM_BETA1,
+                                                  FLOAT_OPTIM_ADAM_BETA2, FLOAT_OPTIM_EPSILON);
+                adam = float_optim_adam(model->parameter_count, 0.01, FLOAT_OPTIM_ADAM_BETA1,
+                                        FLOAT_OPTIM_ADAM_BETA2, FLOAT_OPTIM_EPSILON);
+                float_mlp_set_optimizer(reference, reference_adam);
+                float_mlp_set_optimizer(model, adam);
+            }
+            if (reference != NULL && dp != NULL) {
+                MatrixRng reference_rng, rng;
+                matrix_rng_seed(&reference_rng, 8, 0);
+                matrix_rng_seed(&rng, 8, 0);
+                double reference_loss = 0.0, loss = 0.0;
+                for (int epoch = 0; epoch < 20; epoch++) {
+                    reference_loss = float_mlp_train_epoch(reference, X, Y, 10, 0.05, &reference_rng);
+                    loss = float_dp_train_epoch(dp, X, Y, 10, 0.05, &rng);
+                }
+                printf("%s, %d workers, %s: weights differ by %.2e, losses by %.2e (expected: < 1e-12)\n",
+                       names[r], workers, (workers == 4) ? "Adam" : "SGD ",
+                       max_parameter_difference(reference, model), fabs(reference_loss - loss));
+            }
+            dealloc_float_dp(dp);
+            dealloc_float_optimizer(reference_adam);
+            dealloc_float_optimizer(adam);
+            dealloc_float_mlp(reference);
+            dealloc_float_mlp(model);
+        }
+    }
+
+    // Hogwild: no allocation per epoch, and the loss still comes down
+    FloatMLP *model = float_mlp_create(sizes, activations, 2, 16, 5);
+    FloatDataParallel *dp = (model != NULL) ? float_dp_create(model, 4, FLOAT_REDUCE_TREE) : NULL;
+    if (dp != NULL) {
+        MatrixRng rng;
+        matrix_rng_seed(&rng, 9, 0);
+        double start = dataset_loss(model, X, Y);
+        float_dp_train_epoch_hogwild(dp, X, Y, 16, 0.1, &rng);
+        long allocs_before = matrix_alloc_count();
+        for (int epoch = 1; epoch < 300; epoch++) {
+            float_dp_train_epoch_hogwild(dp, X, Y, 16, 0.1, &rng);
+        }
+        matrix_expect_no_allocs(allocs_before, "299 Hogwild epochs");
+        printf("Hogwild, 4 workers: loss %.4f -> %.4f (expected: below a tenth of the start)\n",
+               start, dataset_loss(model, X, Y));
+    }
+    dealloc_float_dp(dp);
+
+    // An inference-only network has no gradients to reduce
+    FloatMLP *wrapped = model == NULL ? NULL :
+        float_mlp_wrap(sizes, activations, 2, 10, model->parameters->data[0]);
+    if (wrapped != NULL) {
+        dp = float_dp_create(wrapped, 2, FLOAT_REDUCE_TREE);
+        printf("Inference-only model rejected: %s (expected: yes)\n", dp == NULL ? "yes" : "no");
+        dealloc_float_dp(dp);
+        dealloc_float_mlp(wrapped);
+    }
+
+    // Nor can replicas share a parameter block another handle also holds
+    FloatMatrix *snapshot = model == NULL ? NULL : share_float_matrix(model->parameters);
+    if (snapshot != NULL) {
+        dp = float_dp_create(model, 2, FLOAT_REDUCE_TREE);
+        printf("Model with shared parameters rejected: %s (expected: yes)\n", dp == NULL ? "yes" : "no");
+        dealloc_float_dp(dp);
+        dealloc_float_matrix(snapshot);
+    }
+    dealloc_float_mlp(model);
+
+    dealloc_float_matrix(X);
+    dealloc_float_matrix(Y);
+}
+
+#ifndef NO_DP_MAIN
+int main() {
+    printf("Data-Parallel Training Test\n");
+    printf("===========================\n");
+
+    test_float_data_parallel();
+
+    printf("\n✓ All data-parallel tests completed!\n");
+    return 0;
+}
+#endif
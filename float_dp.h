@@ -0,0 +1,45 @@
+#ifndef FLOAT_DP_H
+#define FLOAT_DP_H
+
+#include <stddef.h>
+#include "float_matrix.h"
+#include "float_mlp.h"
+#include "matrix_random.h"
+
+/*
+ * How the workers' gradients are summed. TREE adds replicas pairwise in
+ * log2(workers) rounds. RING gives each thread one chunk of the gradient
+ * vector to sum across all replicas, each thread starting at a different
+ * replica so the threads never read the same replica at once.
+ */
+typedef enum FloatReduction {
+    FLOAT_REDUCE_TREE,
+    FLOAT_REDUCE_RING
+} FloatReduction;
+
+/*
+ * Data-parallel trainer for one FloatMLP. Each of the workers threads owns
+ * a replica of the model (float_mlp_replica): the replicas compute with
+ * the model's weights in place but have their own gradients and batch
+ * workspaces, so a step allocates nothing and copies no weights. The model
+ * must not be shared or freed while the trainer exists.
+ */
+typedef struct FloatDataParallel {
+    FloatMLP *model;
+    int workers;
+    FloatReduction reduction;
+    FloatMLP **replicas;
+} FloatDataParallel;
+
+FloatDataParallel* float_dp_create(FloatMLP *model, int workers, FloatReduction reduction);
+void dealloc_float_dp(FloatDataParallel *dp);
+double float_dp_train_batch(FloatDataParallel *dp, const double *inputs, const double *targets,
+                            size_t batch, double learning_rate);
+double float_dp_train_epoch(FloatDataParallel *dp, FloatMatrix *X, FloatMatrix *Y, size_t batch_size,
+                            double learning_rate, MatrixRng *shuffle);
+double float_dp_train_epoch_hogwild(FloatDataParallel *dp, FloatMatrix *X, FloatMatrix *Y,
+                                    size_t batch_size, double learning_rate, MatrixRng *shuffle);
+
+void test_float_data_parallel(void);
+
+#endif
@@ -0,0 +1,514 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_eigen.h"
+
+/*
+ * Householder reduction of the symmetric n x n matrix in a (overwritten)
+ * to tridiagonal form: d is the diagonal, e[i] couples i and i + 1. The
+ * reflector for step k is I - beta[k] v v^T, with v kept in row k to the
+ * right of the diagonal. Both triangles are updated, so every step is a
+ * row-parallel matrix-vector product plus a row-parallel rank-2 update.
+ */
+static void tridiagonalize(double *a, size_t n, double *d, double *e, double *beta, double *p) {
+    for (size_t k = 0; k + 2 < n; k++) {
+        size_t m = n - k - 1;
+        double *v = a + k * n + k + 1;
+        d[k] = a[k * n + k];
+
+        double norm_sq = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            norm_sq += v[i] * v[i];
+        }
+        if (norm_sq == 0.0) {
+            beta[k] = 0.0;
+            e[k] = 0.0;
+            continue;
+        }
+        double norm = sqrt(norm_sq);
+        double alpha = (v[0] > 0.0) ? -norm : norm;
+        double vv = norm_sq - v[0] * v[0] + (v[0] - alpha) * (v[0] - alpha);
+        v[0] -= alpha;
+        beta[k] = 2.0 / vv;
+        e[k] = alpha;
+
+        long rows = (long)m;
+        int parallel = (double)m * (double)m >= float_tuning()->parallel_threshold;
+        double b = beta[k];
+
+        // p = beta * A22 v
+        #pragma omp parallel for schedule(static) if(parallel)
+        for (long i = 0; i < rows; i++) {
+            const double *row = a + (k + 1 + (size_t)i) * n + k + 1;
+            double sum = 0.0;
+            #pragma omp simd reduction(+:sum)
+            for (size_t j = 0; j < m; j++) {
+                sum += row[j] * v[j];
+            }
+            p[i] = b * sum;
+        }
+
+        // w = p - (beta / 2)(p . v) v, stored over p
+        double pv = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            pv += p[i] * v[i];
+        }
+        double half = 0.5 * b * pv;
+        for (size_t i = 0; i < m; i++) {
+            p[i] -= half * v[i];
+        }
+
+        // A22 -= v w^T + w v^T
+        #pragma omp parallel for schedule(static) if(parallel)
+        for (long i = 0; i < rows; i++) {
+            double *row = a + (k + 1 + (size_t)i) * n + k + 1;
+            double vi = v[i], wi = p[i];
+            #pragma omp simd
+            for (size_t j = 0; j < m; j++) {
+                row[j] -= vi * p[j] + wi * v[j];
+            }
+        }
+    }
+
+    if (n >= 2) {
+        d[n - 2] = a[(n - 2) * n + n - 2];
+        e[n - 2] = a[(n - 2) * n + n - 1];
+    }
+    d[n - 1] = a[(n - 1) * n + n - 1];
+}
+
+/*
+ * Eigenvalues of the tridiagonal (d, e) by implicit QL with Wilkinson
+ * shifts; d is overwritten with them (unsorted), e is destroyed.
+ * Returns 0, or -1 if an eigenvalue does not converge.
+ */
+static int tridiagonal_ql(double *d, double *e, size_t n) {
+    e[n - 1] = 0.0;
+    for (size_t l = 0; l < n; l++) {
+        int sweeps = 0;
+        size_t m;
+        do {
+            for (m = l; m + 1 < n; m++) {
+                double dd = fabs(d[m]) + fabs(d[m + 1]);
+                if (fabs(e[m]) <= 1e-15 * dd) break;
+            }
+            if (m != l) {
+                if (sweeps++ == FLOAT_EIGEN_MAX_SWEEPS) {
+                    return -1;
+                }
+                double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+                double r = hypot(g, 1.0);
+                g = d[m] - d[l] + e[l] / (g + copysign(r, g));
+                double s = 1.0, c = 1.0, p = 0.0;
+                long i;
+                for (i = (long)m - 1; i >= (long)l; i--) {
+                    double f = s * e[i], b = c * e[i];
+                    e[i + 1] = (r = hypot(f, g));
+                    if (r == 0.0) {
+                        d[i + 1] -= p;
+                        e[m] = 0.0;
+                        break;
+                    }
+                    s = f / r;
+                    c = g / r;
+                    g = d[i + 1] - p;
+                    r = (d[i] - g) * s + 2.0 * c * b;
+                    d[i + 1] = g + (p = s * r);
+                    g = c * r - b;
+                }
+                if (r == 0.0 && i >= (long)l) continue;
+                d[l] -= p;
+                e[l] = g;
+                e[m] = 0.0;
+            }
+        } while (m != l);
+    }
+    return 0;
+}
+
+static int descending(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x < y) - (x > y);
+}
+
+/*
+ * Eigenvector of the tridiagonal (d, e) for eigenvalue lambda by inverse
+ * iteration: (T - lambda I) is factored once with partial pivoting and
+ * solved FLOAT_EIGEN_INVERSE_STEPS times, each time re-orthogonalised
+ * against the vectors already found for nearby eigenvalues.
+ */
+static void tridiagonal_vector(const double *d, const double *e, size_t n, double lambda,
+                               double tiny, double *x, double *work,
+                               double *const *previous, const double *previous_values,
+                               size_t previous_count, double cluster) {
+    double *u0 = work, *u1 = work + n, *u2 = work + 2 * n, *l = work + 3 * n;
+    char *swapped = (char *)(work + 4 * n);
+
+    // Row i holds (D, S1, S2) at columns i, i + 1, i + 2
+    double D = d[0] - lambda, S1 = (n > 1) ? e[0] : 0.0, S2 = 0.0;
+    for (size_t i = 0; i + 1 < n; i++) {
+        double sub = e[i], diag = d[i + 1] - lambda, super = (i + 2 < n) ? e[i + 1] : 0.0;
+        if (fabs(D) >= fabs(sub)) {
+            if (D == 0.0) D = tiny;
+            double mult = sub / D;
+            u0[i] = D; u1[i] = S1; u2[i] = S2;
+            l[i] = mult;
+            swapped[i] = 0;
+            D = diag - mult * S1;
+            S1 = super - mult * S2;
+        } else {
+            double mult = D / sub;
+            u0[i] = sub; u1[i] = diag; u2[i] = super;
+            l[i] = mult;
+            swapped[i] = 1;
+            D = S1 - mult * diag;
+            S1 = S2 - mult * super;
+        }
+        S2 = 0.0;
+    }
+    u0[n - 1] = (fabs(D) < tiny) ? tiny : D;
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] = 1.0 + 0.5 * sin(0.7 * (double)i + lambda);
+    }
+    for (int step = 0; step < FLOAT_EIGEN_INVERSE_STEPS; step++) {
+        for (size_t i = 0; i + 1 < n; i++) {
+            if (swapped[i]) {
+                double t = x[i];
+                x[i] = x[i + 1];
+                x[i + 1] = t;
+            }
+            x[i + 1] -= l[i] * x[i];
+        }
+        x[n - 1] /= u0[n - 1];
+        if (n > 1) x[n - 2] = (x[n - 2] - u1[n - 2] * x[n - 1]) / (u0[n - 2] != 0.0 ? u0[n - 2] : tiny);
+        for (long i = (long)n - 3; i >= 0; i--) {
+            double pivot = (u0[i] != 0.0) ? u0[i] : tiny;
+            x[i] = (x[i] - u1[i] * x[i + 1] - u2[i] * x[i + 2]) / pivot;
+        }
+
+        for (size_t q = 0; q < previous_count; q++) {
+            if (fabs(previous_values[q] - lambda) > cluster) continue;
+            double dot = 0.0;
+            for (size_t i = 0; i < n; i++) dot += x[i] * previous[q][i];
+            for (size_t i = 0; i < n; i++) x[i] -= dot * previous[q][i];
+        }
+        double norm = 0.0;
+        for (size_t i = 0; i < n; i++) norm += x[i] * x[i];
+        norm = sqrt(norm);
+        for (size_t i = 0; i < n; i++) x[i] /= norm;
+    }
+}
+
+/*
+ * Top-k eigenpairs of the symmetric A. Reduces a copy of A to tridiagonal
+ * form (the O(n^3) part, threaded), finds all eigenvalues by QL in O(n^2),
+ * then only the k wanted eigenvectors by inverse iteration, and maps them
+ * back through the Householder reflectors one vector per thread.
+ */
+FloatEigen* float_eigen_symmetric(FloatMatrix *A, size_t k) {
+    if (A->rows != A->cols) {
+        printf("Eigen-decomposition needs a square matrix\n");
+        return NULL;
+    }
+    size_t n = A->rows;
+    if (k == 0 || k > n) {
+        printf("Cannot take %zu eigenpairs of a %zu x %zu matrix\n", k, n, n);
+        return NULL;
+    }
+
+    FloatMatrix *work_matrix = create_float_matrix(n, n);
+    FloatEigen *eigen = (FloatEigen *)calloc(1, sizeof(FloatEigen));
+    double *d = (double *)malloc(n * sizeof(double));
+    double *e = (double *)malloc(n * sizeof(double));
+    double *beta = (double *)calloc(n, sizeof(double));
+    double *p = (double *)malloc(n * sizeof(double));
+    double *sorted = (double *)malloc(n * sizeof(double));
+    double *diag_copy = (double *)malloc(n * sizeof(double));
+    FloatMatrix *Y = create_float_matrix(k, n);
+    if (eigen != NULL) {
+        eigen->values = (double *)malloc(k * sizeof(double));
+    }
+    if (work_matrix == NULL || eigen == NULL || eigen->values == NULL || d == NULL || e == NULL ||
+        beta == NULL || p == NULL || sorted == NULL || diag_copy == NULL || Y == NULL) {
+        dealloc_float_matrix(work_matrix);
+        dealloc_float_eigen(eigen);
+        free(d); free(e); free(beta); free(p); free(sorted); free(diag_copy);
+        dealloc_float_matrix(Y);
+        return NULL;
+    }
+
+    double *a = work_matrix->data[0];
+    memcpy(a, A->data[0], n * n * sizeof(double));
+    tridiagonalize(a, n, d, e, beta, p);
+
+    memcpy(sorted, d, n * sizeof(double));
+    memcpy(diag_copy, e, n * sizeof(double));
+    int status = tridiagonal_ql(sorted, diag_copy, n);
+    if (status != 0) {
+        printf("Eigenvalues did not converge\n");
+        dealloc_float_matrix(work_matrix);
+        dealloc_float_eigen(eigen);
+        free(d); free(e); free(beta); free(p); free(sorted); free(diag_copy);
+        dealloc_float_matrix(Y);
+        return NULL;
+    }
+    qsort(sorted, n, sizeof(double), descending);
+    memcpy(eigen->values, sorted, k * sizeof(double));
+    eigen->k = k;
+
+    double scale = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double row = fabs(d[i]) + ((i > 0) ? fabs(e[i - 1]) : 0.0) + ((i + 1 < n) ? fabs(e[i]) : 0.0);
+        if (row > scale) scale = row;
+    }
+    if (scale == 0.0) scale = 1.0;
+    double tiny = 1e-14 * scale;
+    double cluster = 1e-3 * scale;
+
+    double *work = (double *)malloc(4 * n * sizeof(double) + n);
+    if (work == NULL) {
+        dealloc_float_matrix(work_matrix);
+        dealloc_float_eigen(eigen);
+        free(d); free(e); free(beta); free(p); free(sorted); free(diag_copy);
+        dealloc_float_matrix(Y);
+        return NULL;
+    }
+    for (size_t j = 0; j < k; j++) {
+        tridiagonal_vector(d, e, n, eigen->values[j], tiny, Y->data[j], work,
+                           Y->data, eigen->values, j, cluster);
+    }
+    free(work);
+
+    // q = H_0 H_1 ... H_{n-3} z, applied innermost first
+    long vectors = (long)k;
+    int parallel = (double)k * (double)n * (double)n >= float_tuning()->parallel_threshold;
+    #pragma omp parallel for schedule(dynamic, 1) if(parallel)
+    for (long j = 0; j < vectors; j++) {
+        double *y = Y->data[j];
+        for (long r = (long)n - 3; r >= 0; r--) {
+            if (beta[r] == 0.0) continue;
+            const double *v = a + (size_t)r * n + (size_t)r + 1;
+            double *tail = y + r + 1;
+            size_t m = n - (size_t)r - 1;
+            double t = 0.0;
+            #pragma omp simd reduction(+:t)
+            for (size_t i = 0; i < m; i++) {
+                t += v[i] * tail[i];
+            }
+            t *= beta[r];
+            #pragma omp simd
+            for (size_t i = 0; i < m; i++) {
+                tail[i] -= t * v[i];
+            }
+        }
+
+        // Fix the sign so the largest component is positive
+        size_t largest = 0;
+        for (size_t i = 1; i < n; i++) {
+            if (fabs(y[i]) > fabs(y[largest])) largest = i;
+        }
+        if (y[largest] < 0.0) {
+            for (size_t i = 0; i < n; i++) y[i] = -y[i];
+        }
+    }
+
+    eigen->vectors = float_transpose(Y);
+    dealloc_float_matrix(work_matrix);
+    dealloc_float_matrix(Y);
+    free(d); free(e); free(beta); free(p); free(sorted); free(diag_copy);
+    if (eigen->vectors == NULL) {
+        dealloc_float_eigen(eigen);
+        return NULL;
+    }
+    return eigen;
+}
+
+void dealloc_float_eigen(FloatEigen *eigen) {
+    if (eigen == NULL) return;
+    free(eigen->values);
+    free(eigen->means);
+    dealloc_float_matrix(eigen->vectors);
+    free(eigen);
+}
+
+/* Principal components of the rows of X: top-k eigenpairs of its covariance. */
+FloatEigen* float_pca(FloatMatrix *X, size_t k) {
+    FloatMatrix *cov = float_covariance(X);
+    if (cov == NULL) {
+        return NULL;
+    }
+    FloatEigen *components = float_eigen_symmetric(cov, k);
+    dealloc_float_matrix(cov);
+    if (components == NULL) {
+        return NULL;
+    }
+
+    components->means = (double *)calloc(X->cols, sizeof(double));
+    if (components->means == NULL) {
+        dealloc_float_eigen(components);
+        return NULL;
+    }
+    for (size_t r = 0; r < X->rows; r++) {
+        for (size_t j = 0; j < X->cols; j++) {
+            components->means[j] += X->data[r][j];
+        }
+    }
+    for (size_t j = 0; j < X->cols; j++) {
+        components->means[j] /= (double)X->rows;
+    }
+    return components;
+}
+
+/* Scores (X - means) V as one GEMM plus a per-column shift of means^T V. */
+FloatMatrix* float_pca_project(FloatMatrix *X, FloatEigen *components) {
+    if (X->cols != components->vectors->rows) {
+        printf("Cannot project %zu features onto components of %zu\n", X->cols, components->vectors->rows);
+        return NULL;
+    }
+    FloatMatrix *scores = float_multiply_matrix(X, components->vectors);
+    if (scores == NULL || components->means == NULL) {
+        return scores;
+    }
+
+    size_t k = components->k;
+    double *shift = (double *)calloc(k, sizeof(double));
+    if (shift == NULL) {
+        dealloc_float_matrix(scores);
+        return NULL;
+    }
+    for (size_t j = 0; j < X->cols; j++) {
+        for (size_t c = 0; c < k; c++) {
+            shift[c] += components->means[j] * components->vectors->data[j][c];
+        }
+    }
+    for (size_t r = 0; r < scores->rows; r++) {
+        for (size_t c = 0; c < k; c++) {
+            scores->data[r][c] -= shift[c];
+        }
+    }
+    free(shift);
+    return scores;
+}
+
+/* Q diag(values) Q^T with Q = I - 2 u u^T, so the eigenpairs are known exactly. */
+static FloatMatrix* known_spectrum(size_t n, const double *values, double *u) {
+    FloatMatrix *A = create_float_matrix(n, n);
+    if (A == NULL) return NULL;
+    double norm = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        u[i] = sin(1.3 * (double)i + 0.4) + 0.1;
+        norm += u[i] * u[i];
+    }
+    norm = sqrt(norm);
+    for (size_t i = 0; i < n; i++) u[i] /= norm;
+
+    // Q D Q^T = D - 2 u (D u)^T - 2 (D u) u^T + 4 (u^T D u) u u^T
+    double udu = 0.0;
+    for (size_t i = 0; i < n; i++) udu += values[i] * u[i] * u[i];
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A->data[i][j] = (i == j ? values[i] : 0.0)
+                          - 2.0 * u[i] * values[j] * u[j]
+                          - 2.0 * values[i] * u[i] * u[j]
+                          + 4.0 * udu * u[i] * u[j];
+        }
+    }
+    return A;
+}
+
+void test_float_eigen_symmetric() {
+    printf("\n=== Testing Symmetric Eigensolver ===\n");
+
+    size_t n = 300, k = 6;
+    double *values = (double *)malloc(n * sizeof(double));
+    double *u = (double *)malloc(n * sizeof(double));
+    if (values == NULL || u == NULL) {
+        free(values);
+        free(u);
+        return;
+    }
+    // Includes a repeated eigenvalue among the top k
+    for (size_t i = 0; i < n; i++) {
+        values[i] = (double)((i * 37) % n) / 10.0 - 5.0;
+    }
+    values[11] = 30.0;
+    values[47] = 30.0;
+    values[90] = 45.0;
+
+    FloatMatrix *A = known_spectrum(n, values, u);
+    FloatEigen *eigen = A != NULL ? float_eigen_symmetric(A, k) : NULL;
+    if (eigen != NULL) {
+        printf("Top eigenvalues: %.6f %.6f %.6f (expected: 45, 30, 30)\n",
+               eigen->values[0], eigen->values[1], eigen->values[2]);
+
+        double residual = 0.0, orthogonality = 0.0;
+        for (size_t c = 0; c < k; c++) {
+            for (size_t i = 0; i < n; i++) {
+                double av = 0.0;
+                for (size_t j = 0; j < n; j++) av += A->data[i][j] * eigen->vectors->data[j][c];
+                double r = fabs(av - eigen->values[c] * eigen->vectors->data[i][c]);
+                if (r > residual) residual = r;
+            }
+            for (size_t c2 = 0; c2 < k; c2++) {
+                double dot = 0.0;
+                for (size_t i = 0; i < n; i++) dot += eigen->vectors->data[i][c] * eigen->vectors->data[i][c2];
+                double error = fabs(dot - (c == c2 ? 1.0 : 0.0));
+                if (error > orthogonality) orthogonality = error;
+            }
+        }
+        printf("Max |A v - lambda v|: %.3e (expected: < 1e-8)\n", residual);
+        printf("Max |V^T V - I|: %.3e (expected: < 1e-8)\n", orthogonality);
+    }
+
+    dealloc_float_eigen(eigen);
+    dealloc_float_matrix(A);
+    free(values);
+    free(u);
+}
+
+void test_float_pca() {
+    printf("\n=== Testing PCA ===\n");
+
+    // Points along (3, 4)/5 with small noise in the orthogonal direction
+    size_t n = 500;
+    FloatMatrix *X = create_float_matrix(n, 2);
+    if (X == NULL) return;
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)i / (double)n - 0.5;
+        double noise = 0.01 * sin(17.0 * (double)i);
+        X->data[i][0] = 10.0 + 3.0 * t - 4.0 * noise;
+        X->data[i][1] = -2.0 + 4.0 * t + 3.0 * noise;
+    }
+
+    FloatEigen *pca = float_pca(X, 1);
+    if (pca != NULL) {
+        printf("First component: (%.4f, %.4f) (expected: (0.6000, 0.8000))\n",
+               pca->vectors->data[0][0], pca->vectors->data[1][0]);
+        FloatMatrix *scores = float_pca_project(X, pca);
+        if (scores != NULL) {
+            double mean_t = (double)(n - 1) / (2.0 * n) - 0.5;
+            double expected = 5.0 * ((double)(n - 1) / (double)n - 0.5 - mean_t);
+            printf("Score of the last point: %.4f (expected: ~%.4f)\n", scores->data[n - 1][0], expected);
+            dealloc_float_matrix(scores);
+        }
+    }
+
+    dealloc_float_eigen(pca);
+    dealloc_float_matrix(X);
+}
+
+#ifndef NO_EIGEN_MAIN
+int main() {
+    printf("Eigensolver Test\n");
+    printf("================\n");
+
+    test_float_eigen_symmetric();
+    test_float_pca();
+
+    printf("\n✓ All eigensolver tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,33 @@
+#ifndef FLOAT_EIGEN_H
+#define FLOAT_EIGEN_H
+
+#include "float_matrix.h"
+
+/* Inverse-iteration steps per eigenvector of the tridiagonal matrix. */
+#define FLOAT_EIGEN_INVERSE_STEPS 3
+/* QL sweeps allowed per eigenvalue before giving up. */
+#define FLOAT_EIGEN_MAX_SWEEPS 60
+
+/*
+ * Top-k eigenpairs of a symmetric matrix, largest eigenvalue first.
+ * Column j of vectors (n x k) is the unit eigenvector for values[j].
+ * float_pca also keeps the column means of its data so projections of
+ * new rows are centered the same way; means is NULL otherwise.
+ */
+typedef struct FloatEigen {
+    size_t k;
+    double *values;
+    FloatMatrix *vectors;
+    double *means;
+} FloatEigen;
+
+FloatEigen* float_eigen_symmetric(FloatMatrix *A, size_t k);
+void dealloc_float_eigen(FloatEigen *eigen);
+
+FloatEigen* float_pca(FloatMatrix *X, size_t k);
+FloatMatrix* float_pca_project(FloatMatrix *X, FloatEigen *components);
+
+void test_float_eigen_symmetric(void);
+void test_float_pca(void);
+
+#endif
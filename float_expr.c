@@ -0,0 +1,417 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_expr.h"
+
+static FloatExpr* new_node(FloatExprOp op, size_t rows, size_t cols) {
+    FloatExpr *e = (FloatExpr *)malloc(sizeof(FloatExpr));
+    if (e == NULL) {
+        perror("Failed to allocate memory for FloatExpr");
+        return NULL;
+    }
+    e->op = op;
+    e->rows = rows;
+    e->cols = cols;
+    e->scalar = 0.0;
+    e->leaf = NULL;
+    e->left = NULL;
+    e->right = NULL;
+    return e;
+}
+
+FloatExpr* float_expr_leaf(FloatMatrix *m) {
+    if (m == NULL) return NULL;
+    FloatExpr *e = new_node(FLOAT_EXPR_LEAF, m->rows, m->cols);
+    if (e != NULL) {
+        e->leaf = m;
+    }
+    return e;
+}
+
+static FloatExpr* binary_node(FloatExprOp op, FloatExpr *a, FloatExpr *b) {
+    if (a == NULL || b == NULL) {
+        dealloc_float_expr(a);
+        dealloc_float_expr(b);
+        return NULL;
+    }
+
+    size_t rows = a->rows, cols = a->cols;
+    if (op == FLOAT_EXPR_MATMUL) {
+        if (a->cols != b->rows) {
+            printf("Cannot multiply: A.cols (%zu) != B.rows (%zu)\n", a->cols, b->rows);
+            dealloc_float_expr(a);
+            dealloc_float_expr(b);
+            return NULL;
+        }
+        cols = b->cols;
+    } else if (a->rows != b->rows || a->cols != b->cols) {
+        printf("Needs to be the same dimensions\n");
+        dealloc_float_expr(a);
+        dealloc_float_expr(b);
+        return NULL;
+    }
+
+    FloatExpr *e = new_node(op, rows, cols);
+    if (e == NULL) {
+        dealloc_float_expr(a);
+        dealloc_float_expr(b);
+        return NULL;
+    }
+    e->left = a;
+    e->right = b;
+    return e;
+}
+
+FloatExpr* float_expr_add(FloatExpr *a, FloatExpr *b) {
+    return binary_node(FLOAT_EXPR_ADD, a, b);
+}
+
+FloatExpr* float_expr_sub(FloatExpr *a, FloatExpr *b) {
+    return binary_node(FLOAT_EXPR_SUB, a, b);
+}
+
+FloatExpr* float_expr_mul(FloatExpr *a, FloatExpr *b) {
+    return binary_node(FLOAT_EXPR_MUL, a, b);
+}
+
+FloatExpr* float_expr_matmul(FloatExpr *a, FloatExpr *b) {
+    return binary_node(FLOAT_EXPR_MATMUL, a, b);
+}
+
+FloatExpr* float_expr_scale(FloatExpr *a, double scalar) {
+    if (a == NULL) return NULL;
+    FloatExpr *e = new_node(FLOAT_EXPR_SCALE, a->rows, a->cols);
+    if (e == NULL) {
+        dealloc_float_expr(a);
+        return NULL;
+    }
+    e->scalar = scalar;
+    e->left = a;
+    return e;
+}
+
+void dealloc_float_expr(FloatExpr *e) {
+    if (e == NULL) return;
+    dealloc_float_expr(e->left);
+    dealloc_float_expr(e->right);
+    free(e);
+}
+
+/*
+ * Element-wise subtrees compile to a postfix program over chunk-sized
+ * registers. Products are evaluated eagerly through the blocked GEMM and
+ * enter the program as loads of their (temporary) result.
+ */
+typedef struct ExprInstr {
+    FloatExprOp op;
+    const double *source;
+    double scalar;
+} ExprInstr;
+
+typedef struct ExprProgram {
+    ExprInstr *code;
+    size_t length;
+    size_t capacity;
+    size_t depth;
+    size_t max_depth;
+    FloatMatrix **temps;
+    size_t temp_count;
+    size_t temp_capacity;
+} ExprProgram;
+
+static int emit(ExprProgram *p, FloatExprOp op, const double *source, double scalar) {
+    if (p->length == p->capacity) {
+        size_t capacity = p->capacity ? p->capacity * 2 : 16;
+        ExprInstr *code = (ExprInstr *)realloc(p->code, capacity * sizeof(ExprInstr));
+        if (code == NULL) {
+            perror("Failed to grow expression program");
+            return -1;
+        }
+        p->code = code;
+        p->capacity = capacity;
+    }
+    p->code[p->length].op = op;
+    p->code[p->length].source = source;
+    p->code[p->length].scalar = scalar;
+    p->length++;
+    return 0;
+}
+
+static int keep_temp(ExprProgram *p, FloatMatrix *m) {
+    if (p->temp_count == p->temp_capacity) {
+        size_t capacity = p->temp_capacity ? p->temp_capacity * 2 : 4;
+        FloatMatrix **temps = (FloatMatrix **)realloc(p->temps, capacity * sizeof(FloatMatrix *));
+        if (temps == NULL) {
+            perror("Failed to grow expression temporaries");
+            return -1;
+        }
+        p->temps = temps;
+        p->temp_capacity = capacity;
+    }
+    p->temps[p->temp_count++] = m;
+    return 0;
+}
+
+/* Leaves are used in place; anything else is evaluated into a new matrix. */
+static FloatMatrix* materialize(FloatExpr *e, int *owned) {
+    if (e->op == FLOAT_EXPR_LEAF) {
+        *owned = 0;
+        return e->leaf;
+    }
+    *owned = 1;
+    return float_expr_eval(e);
+}
+
+static int compile(FloatExpr *e, ExprProgram *p) {
+    switch (e->op) {
+    case FLOAT_EXPR_LEAF:
+        if (emit(p, FLOAT_EXPR_LEAF, e->leaf->data[0], 0.0) != 0) return -1;
+        break;
+    case FLOAT_EXPR_MATMUL: {
+        int owns_a, owns_b;
+        FloatMatrix *A = materialize(e->left, &owns_a);
+        FloatMatrix *B = A != NULL ? materialize(e->right, &owns_b) : NULL;
+        FloatMatrix *C = (A != NULL && B != NULL) ? float_multiply_matrix(A, B) : NULL;
+        if (A != NULL && owns_a) dealloc_float_matrix(A);
+        if (B != NULL && owns_b) dealloc_float_matrix(B);
+        if (C == NULL || keep_temp(p, C) != 0) {
+            dealloc_float_matrix(C);
+            return -1;
+        }
+        if (emit(p, FLOAT_EXPR_LEAF, C->data[0], 0.0) != 0) return -1;
+        break;
+    }
+    case FLOAT_EXPR_SCALE:
+        if (compile(e->left, p) != 0) return -1;
+        return emit(p, FLOAT_EXPR_SCALE, NULL, e->scalar);
+    default:
+        if (compile(e->left, p) != 0 || compile(e->right, p) != 0) return -1;
+        if (emit(p, e->op, NULL, 0.0) != 0) return -1;
+        p->depth--;
+        return 0;
+    }
+
+    p->depth++;
+    if (p->depth > p->max_depth) {
+        p->max_depth = p->depth;
+    }
+    return 0;
+}
+
+/* Runs the program over elements [offset, offset + count) into out. */
+static void run_chunk(const ExprProgram *p, size_t offset, size_t count,
+                      double *scratch, const double **regs, double *out) {
+    size_t sp = 0;
+    for (size_t pc = 0; pc < p->length; pc++) {
+        const ExprInstr *in = &p->code[pc];
+        int last = pc + 1 == p->length;
+
+        if (in->op == FLOAT_EXPR_LEAF) {
+            regs[sp++] = in->source + offset;
+            if (last) {
+                memcpy(out, regs[0], count * sizeof(double));
+            }
+            continue;
+        }
+
+        if (in->op == FLOAT_EXPR_SCALE) {
+            const double *x = regs[sp - 1];
+            double *dst = last ? out : scratch + (sp - 1) * FLOAT_EXPR_CHUNK;
+            double s = in->scalar;
+            for (size_t e = 0; e < count; e++) {
+                dst[e] = s * x[e];
+            }
+            regs[sp - 1] = dst;
+            continue;
+        }
+
+        const double *x = regs[sp - 2];
+        const double *y = regs[sp - 1];
+        double *dst = last ? out : scratch + (sp - 2) * FLOAT_EXPR_CHUNK;
+        switch (in->op) {
+        case FLOAT_EXPR_ADD:
+            for (size_t e = 0; e < count; e++) dst[e] = x[e] + y[e];
+            break;
+        case FLOAT_EXPR_SUB:
+            for (size_t e = 0; e < count; e++) dst[e] = x[e] - y[e];
+            break;
+        default:
+            for (size_t e = 0; e < count; e++) dst[e] = x[e] * y[e];
+            break;
+        }
+        regs[sp - 2] = dst;
+        sp--;
+    }
+}
+
+/*
+ * Evaluates e into a new matrix. All element-wise operations and scalings
+ * above the products run in a single pass over memory: each thread takes
+ * FLOAT_EXPR_CHUNK elements at a time through the whole program in
+ * L1-resident registers, so only the leaves are read and only the result
+ * is written.
+ */
+FloatMatrix* float_expr_eval(FloatExpr *e) {
+    if (e == NULL) return NULL;
+
+    ExprProgram p;
+    memset(&p, 0, sizeof(p));
+    FloatMatrix *result = NULL;
+
+    if (compile(e, &p) == 0) {
+        result = create_float_matrix(e->rows, e->cols);
+    }
+    if (result != NULL) {
+        size_t total = e->rows * e->cols;
+        long chunks = (long)((total + FLOAT_EXPR_CHUNK - 1) / FLOAT_EXPR_CHUNK);
+        int parallel = (double)total * (double)p.length >= float_tuning()->parallel_threshold;
+        int failed = 0;
+
+        #pragma omp parallel if(parallel)
+        {
+            double *scratch = (double *)malloc(p.max_depth * FLOAT_EXPR_CHUNK * sizeof(double));
+            const double **regs = (const double **)malloc(p.max_depth * sizeof(const double *));
+            if (scratch == NULL || regs == NULL) {
+                #pragma omp atomic write
+                failed = 1;
+            }
+
+            #pragma omp for schedule(static)
+            for (long c = 0; c < chunks; c++) {
+                if (scratch == NULL || regs == NULL) continue;
+                size_t offset = (size_t)c * FLOAT_EXPR_CHUNK;
+                size_t count = (offset + FLOAT_EXPR_CHUNK < total) ? FLOAT_EXPR_CHUNK : total - offset;
+                run_chunk(&p, offset, count, scratch, regs, result->data[0] + offset);
+            }
+
+            free(scratch);
+            free(regs);
+        }
+
+        if (failed) {
+            perror("Failed to allocate expression registers");
+            dealloc_float_matrix(result);
+            result = NULL;
+        }
+    }
+
+    for (size_t t = 0; t < p.temp_count; t++) {
+        dealloc_float_matrix(p.temps[t]);
+    }
+    free(p.temps);
+    free(p.code);
+    return result;
+}
+
+void test_float_expr_elementwise() {
+    printf("\n=== Testing Fused Element-wise Expression ===\n");
+
+    FloatMatrix *A = create_float_matrix(37, 41);
+    FloatMatrix *B = create_float_matrix(37, 41);
+    FloatMatrix *C = create_float_matrix(37, 41);
+    if (A == NULL || B == NULL || C == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        dealloc_float_matrix(C);
+        return;
+    }
+    for (size_t i = 0; i < 37; i++) {
+        for (size_t j = 0; j < 41; j++) {
+            A->data[i][j] = (double)i - (double)j * 0.5;
+            B->data[i][j] = (double)(i * j % 7) + 1.0;
+            C->data[i][j] = (double)((i + j) % 5) - 2.0;
+        }
+    }
+
+    // ((2A + B) - C) .* B * 0.5 + A
+    FloatExpr *e = float_expr_add(
+        float_expr_scale(
+            float_expr_mul(
+                float_expr_sub(
+                    float_expr_add(float_expr_scale(float_expr_leaf(A), 2.0), float_expr_leaf(B)),
+                    float_expr_leaf(C)),
+                float_expr_leaf(B)),
+            0.5),
+        float_expr_leaf(A));
+
+    FloatMatrix *R = float_expr_eval(e);
+    if (R != NULL) {
+        double max_error = 0.0;
+        for (size_t i = 0; i < 37; i++) {
+            for (size_t j = 0; j < 41; j++) {
+                double a = A->data[i][j], b = B->data[i][j], c = C->data[i][j];
+                double expected = ((2.0 * a + b) - c) * b * 0.5 + a;
+                double error = fabs(expected - R->data[i][j]);
+                if (error > max_error) max_error = error;
+            }
+        }
+        printf("Max error vs direct formula: %.3e (expected: 0)\n", max_error);
+        dealloc_float_matrix(R);
+    }
+
+    // Mismatched shapes are rejected and the partial tree freed
+    FloatMatrix *D = create_float_matrix(2, 2);
+    FloatExpr *bad = float_expr_add(float_expr_leaf(A), float_expr_leaf(D));
+    printf("Mismatched add: %s (expected: rejected)\n", bad == NULL ? "rejected" : "accepted");
+
+    dealloc_float_expr(e);
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(B);
+    dealloc_float_matrix(C);
+    dealloc_float_matrix(D);
+}
+
+void test_float_expr_matmul() {
+    printf("\n=== Testing Expression With Products ===\n");
+
+    FloatMatrix *A = create_float_matrix(2, 3);
+    FloatMatrix *B = create_float_matrix(3, 2);
+    FloatMatrix *I = create_float_matrix(2, 2);
+    if (A == NULL || B == NULL || I == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        dealloc_float_matrix(I);
+        return;
+    }
+    A->data[0][0] = 1; A->data[0][1] = 2; A->data[0][2] = 3;
+    A->data[1][0] = 4; A->data[1][1] = 5; A->data[1][2] = 6;
+    B->data[0][0] = 7; B->data[0][1] = 8;
+    B->data[1][0] = 9; B->data[1][1] = 10;
+    B->data[2][0] = 11; B->data[2][1] = 12;
+    I->data[0][0] = 1; I->data[0][1] = 0;
+    I->data[1][0] = 0; I->data[1][1] = 1;
+
+    // (A * B) * 2 - I
+    FloatExpr *e = float_expr_sub(
+        float_expr_scale(float_expr_matmul(float_expr_leaf(A), float_expr_leaf(B)), 2.0),
+        float_expr_leaf(I));
+    FloatMatrix *R = float_expr_eval(e);
+    if (R != NULL) {
+        printf("Result:\n");
+        float_matrix_print(R);
+        printf("Expected:\n");
+        printf("115.0000 128.0000\n");
+        printf("278.0000 307.0000\n");
+        dealloc_float_matrix(R);
+    }
+
+    dealloc_float_expr(e);
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(B);
+    dealloc_float_matrix(I);
+}
+
+#ifndef NO_EXPR_MAIN
+int main() {
+    printf("FloatMatrix Expression Test\n");
+    printf("===========================\n");
+
+    test_float_expr_elementwise();
+    test_float_expr_matmul();
+
+    printf("\n✓ All expression tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,47 @@
+#ifndef FLOAT_EXPR_H
+#define FLOAT_EXPR_H
+
+#include "float_matrix.h"
+
+/* Elements per register chunk when float_expr_eval runs a fused pass. */
+#define FLOAT_EXPR_CHUNK 512
+
+typedef enum FloatExprOp {
+    FLOAT_EXPR_LEAF,
+    FLOAT_EXPR_ADD,
+    FLOAT_EXPR_SUB,
+    FLOAT_EXPR_MUL,      // Element-wise (Hadamard) product
+    FLOAT_EXPR_SCALE,
+    FLOAT_EXPR_MATMUL
+} FloatExprOp;
+
+/*
+ * Deferred FloatMatrix expression. Nodes own their children; leaves only
+ * borrow their matrix, which must outlive the evaluation. Builders take
+ * ownership of their operands and free them if they return NULL, so
+ * chains can be nested without leaking on a dimension mismatch.
+ */
+typedef struct FloatExpr {
+    FloatExprOp op;
+    size_t rows;
+    size_t cols;
+    double scalar;
+    FloatMatrix *leaf;
+    struct FloatExpr *left;
+    struct FloatExpr *right;
+} FloatExpr;
+
+FloatExpr* float_expr_leaf(FloatMatrix *m);
+FloatExpr* float_expr_add(FloatExpr *a, FloatExpr *b);
+FloatExpr* float_expr_sub(FloatExpr *a, FloatExpr *b);
+FloatExpr* float_expr_mul(FloatExpr *a, FloatExpr *b);
+FloatExpr* float_expr_scale(FloatExpr *a, double scalar);
+FloatExpr* float_expr_matmul(FloatExpr *a, FloatExpr *b);
+void dealloc_float_expr(FloatExpr *e);
+
+FloatMatrix* float_expr_eval(FloatExpr *e);
+
+void test_float_expr_elementwise(void);
+void test_float_expr_matmul(void);
+
+#endif
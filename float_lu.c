@@ -0,0 +1,628 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_lu.h"
+
+/*
+ * Factors the block column starting at column k0 (kb wide, rows k0..n-1)
+ * with partial pivoting. Row swaps are applied inside the panel only; the
+ * columns to the right are swapped by lu_swap_trsm and those to the left
+ * once the whole factorization has finished.
+ */
+static void lu_panel(double *a, size_t n, size_t k0, size_t kb, double tolerance,
+                     size_t *pivots, int *sign, int *failed) {
+    for (size_t p = k0; p < k0 + kb; p++) {
+        size_t pivot_row = p;
+        double max_val = fabs(a[p * n + p]);
+        for (size_t i = p + 1; i < n; i++) {
+            double abs_val = fabs(a[i * n + p]);
+            if (abs_val > max_val) {
+                max_val = abs_val;
+                pivot_row = i;
+            }
+        }
+        if (max_val == 0.0 || max_val < tolerance) {
+            *failed = 1;
+            return;
+        }
+        pivots[p] = pivot_row;
+        if (pivot_row != p) {
+            for (size_t j = k0; j < k0 + kb; j++) {
+                double temp = a[p * n + j];
+                a[p * n + j] = a[pivot_row * n + j];
+                a[pivot_row * n + j] = temp;
+            }
+            *sign = -*sign;
+        }
+
+        const double *row_p = a + p * n;
+        double pivot = row_p[p];
+        for (size_t i = p + 1; i < n; i++) {
+            double *row_i = a + i * n;
+            double factor = row_i[p] / pivot;
+            row_i[p] = factor;
+            for (size_t j = p + 1; j < k0 + kb; j++) {
+                row_i[j] -= factor * row_p[j];
+            }
+        }
+    }
+}
+
+/* Applies panel k's row swaps to block column j0, then U_kj = L_kk^-1 A_kj. */
+static void lu_swap_trsm(double *a, size_t n, size_t k0, size_t kb,
+                         const size_t *pivots, size_t j0, size_t jb) {
+    for (size_t p = k0; p < k0 + kb; p++) {
+        if (pivots[p] != p) {
+            double *row_p = a + p * n, *row_q = a + pivots[p] * n;
+            for (size_t j = j0; j < j0 + jb; j++) {
+                double temp = row_p[j];
+                row_p[j] = row_q[j];
+                row_q[j] = temp;
+            }
+        }
+    }
+    for (size_t i = k0 + 1; i < k0 + kb; i++) {
+        double *row_i = a + i * n;
+        for (size_t p = k0; p < i; p++) {
+            double l = row_i[p];
+            const double *row_p = a + p * n;
+            for (size_t j = j0; j < j0 + jb; j++) {
+                row_i[j] -= l * row_p[j];
+            }
+        }
+    }
+}
+
+/*
+ * Tiled right-looking LU with partial pivoting on a row-major n x n buffer.
+ * Every step k issues one panel task, one swap+trsm task per tile column
+ * to its right and one gemm task per trailing tile, linked by OpenMP task
+ * dependencies on per-tile sentinels. The runtime can therefore start
+ * panel k+1 as soon as its own column has been updated, while the rest of
+ * step k's trailing update is still running.
+ * Returns -1 if a pivot's magnitude is zero or below tolerance.
+ */
+int float_lu_decompose_tol(double *a, size_t n, size_t *pivots, int *sign, double tolerance) {
+    size_t b = float_tuning()->lu_block;
+    long nt = (long)((n + b - 1) / b);
+    char *deps = (char *)malloc((size_t)nt * (size_t)nt);
+    if (deps == NULL) {
+        perror("Failed to allocate LU task dependencies");
+        return -1;
+    }
+    for (size_t p = 0; p < n; p++) {
+        pivots[p] = p;
+    }
+    *sign = 1;
+    int failed = 0;
+
+    #pragma omp parallel
+    #pragma omp single
+    for (long k = 0; k < nt; k++) {
+        size_t k0 = (size_t)k * b;
+        size_t kb = (k0 + b < n) ? b : n - k0;
+
+        #pragma omp task depend(iterator(long it = k:nt), inout: deps[it * nt + k])
+        lu_panel(a, n, k0, kb, tolerance, pivots, sign, &failed);
+
+        for (long j = k + 1; j < nt; j++) {
+            size_t j0 = (size_t)j * b;
+            size_t jb = (j0 + b < n) ? b : n - j0;
+
+            #pragma omp task depend(in: deps[k * nt + k]) depend(iterator(long it = k:nt), inout: deps[it * nt + j])
+            lu_swap_trsm(a, n, k0, kb, pivots, j0, jb);
+
+            for (long i = k + 1; i < nt; i++) {
+                size_t i0 = (size_t)i * b;
+                size_t ib = (i0 + b < n) ? b : n - i0;
+
+                #pragma omp task depend(in: deps[i * nt + k], deps[k * nt + j]) depend(inout: deps[i * nt + j])
+                float_gemm_kernel(ib, jb, kb, -1.0, a + i0 * n + k0, n,
+                                  a + k0 * n + j0, n, a + i0 * n + j0, n);
+            }
+        }
+    }
+
+    free(deps);
+    if (failed) {
+        return -1;
+    }
+
+    // L columns left of each panel still need that panel's row swaps
+    for (size_t p = b; p < n; p++) {
+        if (pivots[p] != p) {
+            size_t left = p - p % b;
+            double *row_p = a + p * n, *row_q = a + pivots[p] * n;
+            for (size_t j = 0; j < left; j++) {
+                double temp = row_p[j];
+                row_p[j] = row_q[j];
+                row_q[j] = temp;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Fails under the same 1e-10 singularity tolerance float_matrix_inverse uses. */
+int float_lu_decompose(double *a, size_t n, size_t *pivots, int *sign) {
+    return float_lu_decompose_tol(a, n, pivots, sign, 1e-10);
+}
+
+static int lu_factor_single(float *a, size_t n, size_t *pivots) {
+    for (size_t k = 0; k < n; k++) {
+        size_t pivot_row = k;
+        float max_val = fabsf(a[k * n + k]);
+        for (size_t i = k + 1; i < n; i++) {
+            float abs_val = fabsf(a[i * n + k]);
+            if (abs_val > max_val) {
+                max_val = abs_val;
+                pivot_row = i;
+            }
+        }
+        if (max_val == 0.0f || !isfinite(max_val)) {
+            return -1;
+        }
+        pivots[k] = pivot_row;
+        if (pivot_row != k) {
+            for (size_t j = 0; j < n; j++) {
+                float temp = a[k * n + j];
+                a[k * n + j] = a[pivot_row * n + j];
+                a[pivot_row * n + j] = temp;
+            }
+        }
+
+        const float *row_k = a + k * n;
+        float pivot = row_k[k];
+        long rows = (long)(n - k - 1);
+        int parallel = (double)rows * (double)rows >= float_tuning()->parallel_threshold;
+
+        #pragma omp parallel for schedule(static) if(parallel)
+        for (long r = 0; r < rows; r++) {
+            float *row_i = a + (k + 1 + (size_t)r) * n;
+            float factor = row_i[k] / pivot;
+            row_i[k] = factor;
+            for (size_t j = k + 1; j < n; j++) {
+                row_i[j] -= factor * row_k[j];
+            }
+        }
+    }
+    return 0;
+}
+
+/* Solves L U X = P B in place for columns j0..j1 of an n x nrhs row-major B. */
+static void lu_solve_double(const double *a, size_t n, const size_t *pivots,
+                            double *b, size_t nrhs, size_t j0, size_t j1) {
+    for (size_t k = 0; k < n; k++) {
+        if (pivots[k] != k) {
+            for (size_t j = j0; j < j1; j++) {
+                double temp = b[k * nrhs + j];
+                b[k * nrhs + j] = b[pivots[k] * nrhs + j];
+                b[pivots[k] * nrhs + j] = temp;
+            }
+        }
+    }
+    for (size_t i = 1; i < n; i++) {
+        double *b_i = b + i * nrhs;
+        for (size_t k = 0; k < i; k++) {
+            double l = a[i * n + k];
+            const double *b_k = b + k * nrhs;
+            for (size_t j = j0; j < j1; j++) {
+                b_i[j] -= l * b_k[j];
+            }
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        double *b_i = b + i * nrhs;
+        for (size_t k = i + 1; k < n; k++) {
+            double u = a[i * n + k];
+            const double *b_k = b + k * nrhs;
+            for (size_t j = j0; j < j1; j++) {
+                b_i[j] -= u * b_k[j];
+            }
+        }
+        double diag = a[i * n + i];
+        for (size_t j = j0; j < j1; j++) {
+            b_i[j] /= diag;
+        }
+    }
+}
+
+static void lu_solve_single(const float *a, size_t n, const size_t *pivots,
+                            float *b, size_t nrhs) {
+    for (size_t k = 0; k < n; k++) {
+        if (pivots[k] != k) {
+            for (size_t j = 0; j < nrhs; j++) {
+                float temp = b[k * nrhs + j];
+                b[k * nrhs + j] = b[pivots[k] * nrhs + j];
+                b[pivots[k] * nrhs + j] = temp;
+            }
+        }
+    }
+    for (size_t i = 1; i < n; i++) {
+        float *b_i = b + i * nrhs;
+        for (size_t k = 0; k < i; k++) {
+            float l = a[i * n + k];
+            const float *b_k = b + k * nrhs;
+            for (size_t j = 0; j < nrhs; j++) {
+                b_i[j] -= l * b_k[j];
+            }
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        float *b_i = b + i * nrhs;
+        for (size_t k = i + 1; k < n; k++) {
+            float u = a[i * n + k];
+            const float *b_k = b + k * nrhs;
+            for (size_t j = 0; j < nrhs; j++) {
+                b_i[j] -= u * b_k[j];
+            }
+        }
+        float diag = a[i * n + i];
+        for (size_t j = 0; j < nrhs; j++) {
+            b_i[j] /= diag;
+        }
+    }
+}
+
+FloatLU* float_lu_factor(FloatMatrix *m) {
+    if (m->rows != m->cols) {
+        printf("LU factorization needs a square matrix\n");
+        return NULL;
+    }
+    size_t n = m->rows;
+
+    FloatLU *lu = (FloatLU *)malloc(sizeof(FloatLU));
+    if (lu == NULL) {
+        perror("Failed to allocate memory for FloatLU");
+        return NULL;
+    }
+    lu->lu = create_float_matrix(n, n);
+    lu->pivots = (size_t *)malloc(n * sizeof(size_t));
+    if (lu->lu == NULL || lu->pivots == NULL) {
+        dealloc_float_lu(lu);
+        return NULL;
+    }
+    memcpy(lu->lu->data[0], m->data[0], n * n * sizeof(double));
+
+    if (float_lu_decompose(lu->lu->data[0], n, lu->pivots, &lu->sign) != 0) {
+        printf("Matrix is singular, cannot be factorized\n");
+        dealloc_float_lu(lu);
+        return NULL;
+    }
+    return lu;
+}
+
+void dealloc_float_lu(FloatLU *lu) {
+    if (lu == NULL) return;
+    dealloc_float_matrix(lu->lu);
+    free(lu->pivots);
+    free(lu);
+}
+
+/*
+ * Overwrites B with the solution, after unsharing it. Right-hand side
+ * columns are independent, so chunks of them go to threads.
+ */
+void float_lu_solve_in_place(FloatLU *lu, FloatMatrix *B) {
+    if (float_make_writable(B) != 0) return;
+    size_t n = lu->lu->rows, nrhs = B->cols;
+    const FloatTuning *tuning = float_tuning();
+    size_t chunk = tuning->lu_block;
+    long chunks = (long)((nrhs + chunk - 1) / chunk);
+    int parallel = chunks > 1 && (double)n * (double)n * (double)nrhs >= tuning->parallel_threshold;
+
+    #pragma omp parallel for schedule(dynamic) if(parallel)
+    for (long c = 0; c < chunks; c++) {
+        size_t j0 = (size_t)c * chunk;
+        size_t j1 = (j0 + chunk < nrhs) ? j0 + chunk : nrhs;
+        lu_solve_double(lu->lu->data[0], n, lu->pivots, B->data[0], nrhs, j0, j1);
+    }
+}
+
+double float_lu_determinant(FloatLU *lu) {
+    double det = (double)lu->sign;
+    for (size_t i = 0; i < lu->lu->rows; i++) {
+        det *= lu->lu->data[i][i];
+    }
+    return det;
+}
+
+FloatMatrix* float_solve(FloatMatrix *A, FloatMatrix *B) {
+    if (A->rows != A->cols || B->rows != A->rows) {
+        printf("Cannot solve: A must be square with as many rows as B\n");
+        return NULL;
+    }
+
+    FloatLU *lu = float_lu_factor(A);
+    if (lu == NULL) {
+        return NULL;
+    }
+    FloatMatrix *X = create_float_matrix(B->rows, B->cols);
+    if (X != NULL) {
+        memcpy(X->data[0], B->data[0], B->rows * B->cols * sizeof(double));
+        float_lu_solve_in_place(lu, X);
+    }
+    dealloc_float_lu(lu);
+    return X;
+}
+
+static double max_abs(const double *v, size_t count) {
+    double result = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double abs_val = fabs(v[i]);
+        if (abs_val > result) result = abs_val;
+    }
+    return result;
+}
+
+/*
+ * Solves A X = B by factorizing a float32 copy of A, then refining X with
+ * residuals R = A X - B computed in double. Each correction reuses the
+ * float factors, so the O(n^3) work runs at single precision speed.
+ * Stops when ||R|| <= ||A|| ||X|| eps sqrt(n) (the LAPACK dsgesv test).
+ * *iterations receives the number of refinement steps, or -1 when the
+ * float path failed or stalled and a full double LU solve was used.
+ */
+FloatMatrix* float_solve_mixed(FloatMatrix *A, FloatMatrix *B, int *iterations) {
+    if (A->rows != A->cols || B->rows != A->rows) {
+        printf("Cannot solve: A must be square with as many rows as B\n");
+        return NULL;
+    }
+    size_t n = A->rows, nrhs = B->cols, count = n * nrhs;
+
+    float *af = (float *)malloc(n * n * sizeof(float));
+    float *xf = (float *)malloc(count * sizeof(float));
+    size_t *pivots = (size_t *)malloc(n * sizeof(size_t));
+    FloatMatrix *X = create_float_matrix(n, nrhs);
+    FloatMatrix *R = create_float_matrix(n, nrhs);
+    if (af == NULL || xf == NULL || pivots == NULL || X == NULL || R == NULL) {
+        free(af);
+        free(xf);
+        free(pivots);
+        dealloc_float_matrix(X);
+        dealloc_float_matrix(R);
+        return NULL;
+    }
+
+    const double *a = A->data[0];
+    double a_norm = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double row_sum = 0.0;
+        for (size_t j = 0; j < n; j++) {
+            af[i * n + j] = (float)a[i * n + j];
+            row_sum += fabs(a[i * n + j]);
+        }
+        if (row_sum > a_norm) a_norm = row_sum;
+    }
+
+    int converged = 0;
+    int steps = 0;
+    double *x = X->data[0], *r = R->data[0];
+    const double *b = B->data[0];
+    if (lu_factor_single(af, n, pivots) == 0) {
+        for (size_t i = 0; i < count; i++) xf[i] = (float)b[i];
+        lu_solve_single(af, n, pivots, xf, nrhs);
+        for (size_t i = 0; i < count; i++) x[i] = (double)xf[i];
+
+        double tolerance = a_norm * DBL_EPSILON * sqrt((double)n);
+        for (steps = 0; steps <= FLOAT_REFINE_MAX_ITERATIONS; steps++) {
+            for (size_t i = 0; i < count; i++) r[i] = -b[i];
+            float_gemm_kernel(n, nrhs, n, 1.0, a, n, x, nrhs, r, nrhs);
+
+            double r_norm = max_abs(r, count);
+            if (!isfinite(r_norm)) break;
+            if (r_norm <= max_abs(x, count) * tolerance) {
+                converged = 1;
+                break;
+            }
+            if (steps == FLOAT_REFINE_MAX_ITERATIONS) break;
+
+            for (size_t i = 0; i < count; i++) xf[i] = (float)r[i];
+            lu_solve_single(af, n, pivots, xf, nrhs);
+            for (size_t i = 0; i < count; i++) x[i] -= (double)xf[i];
+        }
+    }
+
+    free(af);
+    free(xf);
+    free(pivots);
+    dealloc_float_matrix(R);
+
+    if (!converged) {
+        dealloc_float_matrix(X);
+        if (iterations != NULL) *iterations = -1;
+        return float_solve(A, B);
+    }
+    if (iterations != NULL) *iterations = steps;
+    return X;
+}
+
+void test_float_solve() {
+    printf("\n=== Testing LU Solve ===\n");
+
+    FloatMatrix *A = create_float_matrix(3, 3);
+    FloatMatrix *b = create_float_matrix(3, 1);
+    if (A == NULL || b == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(b);
+        return;
+    }
+    A->data[0][0] = 2.0; A->data[0][1] = 1.0; A->data[0][2] = -1.0;
+    A->data[1][0] = -3.0; A->data[1][1] = -1.0; A->data[1][2] = 2.0;
+    A->data[2][0] = -2.0; A->data[2][1] = 1.0; A->data[2][2] = 2.0;
+    b->data[0][0] = 8.0; b->data[1][0] = -11.0; b->data[2][0] = -3.0;
+
+    FloatMatrix *x = float_solve(A, b);
+    if (x != NULL) {
+        printf("Solution:\n");
+        float_matrix_print(x);
+        printf("Expected: 2, 3, -1\n");
+        dealloc_float_matrix(x);
+    }
+
+    FloatLU *lu = float_lu_factor(A);
+    if (lu != NULL) {
+        printf("Determinant from LU: %.2f (expected: -1.00)\n", float_lu_determinant(lu));
+
+        // Solving into a shared handle must leave the other handle's values alone
+        FloatMatrix *shared = share_float_matrix(b);
+        if (shared != NULL) {
+            float_lu_solve_in_place(lu, shared);
+            printf("In-place solve into a shared copy: x = %.2f, %.2f, %.2f; b = %.2f, %.2f, %.2f "
+                   "(expected: x = 2, 3, -1; b = 8, -11, -3)\n",
+                   shared->data[0][0], shared->data[1][0], shared->data[2][0],
+                   b->data[0][0], b->data[1][0], b->data[2][0]);
+            dealloc_float_matrix(shared);
+        }
+        dealloc_float_lu(lu);
+    }
+
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(b);
+}
+
+void test_float_solve_mixed() {
+    printf("\n=== Testing Mixed-Precision Solve ===\n");
+
+    size_t n = 800;
+    FloatMatrix *A = create_float_matrix(n, n);
+    FloatMatrix *b = create_float_matrix(n, 1);
+    if (A == NULL || b == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(b);
+        return;
+    }
+    // Diagonally dominant, so well conditioned
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A->data[i][j] = (double)((i * 31 + j * 17) % 23) / 23.0 - 0.5;
+        }
+        A->data[i][i] += (double)n;
+        b->data[i][0] = (double)(i % 7) - 3.0;
+    }
+
+    double start = float_wall_seconds();
+    FloatMatrix *x_double = float_solve(A, b);
+    double double_seconds = float_wall_seconds() - start;
+
+    int iterations = 0;
+    start = float_wall_seconds();
+    FloatMatrix *x_mixed = float_solve_mixed(A, b, &iterations);
+    double mixed_seconds = float_wall_seconds() - start;
+
+    if (x_double != NULL && x_mixed != NULL) {
+        double max_diff = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double diff = fabs(x_double->data[i][0] - x_mixed->data[i][0]);
+            if (diff > max_diff) max_diff = diff;
+        }
+        printf("n = %zu, refinement steps: %d\n", n, iterations);
+        printf("Max difference from double solve: %.3e (expected: < 1e-12)\n", max_diff);
+        printf("Double LU: %.4f s, mixed precision: %.4f s\n", double_seconds, mixed_seconds);
+    }
+
+    // A singular matrix must not come back from either path
+    FloatMatrix *S = create_float_matrix(2, 2);
+    FloatMatrix *s = create_float_matrix(2, 1);
+    if (S != NULL && s != NULL) {
+        S->data[0][0] = 1.0; S->data[0][1] = 2.0;
+        S->data[1][0] = 2.0; S->data[1][1] = 4.0;
+        s->data[0][0] = 1.0; s->data[1][0] = 2.0;
+        FloatMatrix *x_singular = float_solve_mixed(S, s, &iterations);
+        printf("Singular system: %s (expected: rejected)\n", x_singular == NULL ? "rejected" : "solved");
+        dealloc_float_matrix(x_singular);
+    }
+
+    dealloc_float_matrix(S);
+    dealloc_float_matrix(s);
+    dealloc_float_matrix(x_double);
+    dealloc_float_matrix(x_mixed);
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(b);
+}
+
+/* Deterministic pseudo-random entry in [-0.5, 0.5) without repeating rows. */
+static double test_entry(size_t i, size_t j) {
+    unsigned long long h = (unsigned long long)i * 0x9E3779B97F4A7C15ULL + (unsigned long long)j;
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return (double)(h % 1000003ULL) / 1000003.0 - 0.5;
+}
+
+void test_float_lu_tiled() {
+    printf("\n=== Testing Tiled LU ===\n");
+
+    // Several tiles with a ragged edge, and entries that force row swaps
+    size_t n = 2 * FLOAT_LU_BLOCK + 45;
+    FloatMatrix *A = create_float_matrix(n, n);
+    FloatMatrix *b = create_float_matrix(n, 1);
+    if (A == NULL || b == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(b);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A->data[i][j] = test_entry(i, j);
+        }
+        b->data[i][0] = (double)(i % 5) - 2.0;
+    }
+
+    FloatMatrix *x = float_solve(A, b);
+    if (x != NULL) {
+        double max_residual = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double sum = -b->data[i][0];
+            for (size_t j = 0; j < n; j++) {
+                sum += A->data[i][j] * x->data[j][0];
+            }
+            if (fabs(sum) > max_residual) max_residual = fabs(sum);
+        }
+        printf("n = %zu, max residual |Ax - b|: %.3e (expected: < 1e-9)\n", n, max_residual);
+        dealloc_float_matrix(x);
+    }
+
+    FloatMatrix *inv = float_matrix_inverse(A);
+    if (inv != NULL) {
+        FloatMatrix *identity = float_multiply_matrix(A, inv);
+        if (identity != NULL) {
+            double max_error = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    double error = fabs(identity->data[i][j] - (i == j ? 1.0 : 0.0));
+                    if (error > max_error) max_error = error;
+                }
+            }
+            printf("max |A * A^-1 - I|: %.3e (expected: < 1e-9)\n", max_error);
+            dealloc_float_matrix(identity);
+        }
+        dealloc_float_matrix(inv);
+    }
+
+    // Duplicate a row in the last tile: the determinant must collapse to 0
+    for (size_t j = 0; j < n; j++) {
+        A->data[n - 1][j] = A->data[3][j];
+    }
+    printf("Determinant with a repeated row: %.2f (expected: 0.00)\n", float_determinant(A));
+
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(b);
+}
+
+#ifndef NO_LU_MAIN
+int main() {
+    printf("FloatMatrix LU Solver Test\n");
+    printf("==========================\n");
+
+    test_float_solve();
+    test_float_solve_mixed();
+    test_float_lu_tiled();
+
+    printf("\n✓ All LU solver tests completed!\n");
+    return 0;
+}
+#endif
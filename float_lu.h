@@ -0,0 +1,29 @@
+#ifndef FLOAT_LU_H
+#define FLOAT_LU_H
+
+#include "float_matrix.h"
+
+/* Refinement steps float_solve_mixed tries before refactoring in double. */
+#define FLOAT_REFINE_MAX_ITERATIONS 10
+
+typedef struct FloatLU {
+    FloatMatrix *lu;   // Unit lower L below the diagonal, U on and above
+    size_t *pivots;    // Step k swapped rows k and pivots[k]
+    int sign;          // Parity of the row swaps, for the determinant
+} FloatLU;
+
+int float_lu_decompose_tol(double *a, size_t n, size_t *pivots, int *sign, double tolerance);
+int float_lu_decompose(double *a, size_t n, size_t *pivots, int *sign);
+FloatLU* float_lu_factor(FloatMatrix *m);
+void dealloc_float_lu(FloatLU *lu);
+void float_lu_solve_in_place(FloatLU *lu, FloatMatrix *B);
+double float_lu_determinant(FloatLU *lu);
+
+FloatMatrix* float_solve(FloatMatrix *A, FloatMatrix *B);
+FloatMatrix* float_solve_mixed(FloatMatrix *A, FloatMatrix *B, int *iterations);
+
+void test_float_solve(void);
+void test_float_solve_mixed(void);
+void test_float_lu_tiled(void);
+
+#endif
@@ -1,12 +1,31 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "matrix.h"
 #include "float_matrix.h"
+#include "float_lu.h"
+#include "float_numa.h"
 
-double determinant(Matrix *m);
 
-FloatMatrix* create_float_matrix(int r, int c) {
+FloatMatrix* create_float_matrix(size_t r, size_t c) {
+    size_t count, bytes, row_bytes;
+
+    if (r == 0 || c == 0) {
+        printf("Matrix dimensions must be positive\n");
+        return NULL;
+    }
+    if (!matrix_size_mul(r, c, &count) ||
+        !matrix_size_mul(count, sizeof(double), &bytes) ||
+        !matrix_size_mul(r, sizeof(double *), &row_bytes)) {
+        printf("FloatMatrix of %zu x %zu elements is too large to allocate\n", r, c);
+        return NULL;
+    }
+
     FloatMatrix *m = (FloatMatrix *)malloc(sizeof(FloatMatrix));
     if (m == NULL) {
         perror("Failed to allocate memory for FloatMatrix");
@@ -16,48 +35,113 @@ FloatMatrix* create_float_matrix(int r, int c) {
     m->rows = r;
     m->cols = c;
 
-    m->data = (double **)malloc(r * sizeof(double *));
+    m->data = (double **)matrix_storage_alloc(row_bytes);
     if (m->data == NULL) {
         perror("Failed to allocate memory for data rows");
         free(m);
         return NULL;
     }
 
-    for (int i = 0; i < r; i++) {
-        m->data[i] = (double *)malloc(c * sizeof(double));
-        if (m->data[i] == NULL) {
-            perror("Failed to allocate memory for data columns");
-            for (int j = 0; j < i; j++) {
-                free(m->data[j]);
-            }
-            free(m->data);
-            free(m);
-            return NULL;
-        }
+    double *block = (double *)malloc(bytes);
+    if (block == NULL) {
+        perror("Failed to allocate memory for matrix elements");
+        matrix_storage_release(m->data);
+        free(m);
+        return NULL;
+    }
+    if (bytes >= FLOAT_NUMA_MIN_BYTES) {
+        float_place_rows(block, r, c);
+    }
+    for (size_t i = 0; i < r; i++) {
+        m->data[i] = block + i * c;
+    }
+    return m;
+}
+
+/*
+ * r x c handle on elements the caller owns, row-major at block. It shares
+ * and copies-on-write like any FloatMatrix, but dealloc never frees block.
+ */
+FloatMatrix* float_matrix_view(double *block, size_t r, size_t c) {
+    size_t row_bytes;
+    if (r == 0 || c == 0 || !matrix_size_mul(r, sizeof(double *), &row_bytes)) {
+        printf("Cannot view %zu x %zu elements\n", r, c);
+        return NULL;
+    }
+    FloatMatrix *m = (FloatMatrix *)malloc(sizeof(FloatMatrix));
+    if (m == NULL) {
+        perror("Failed to allocate memory for FloatMatrix");
+        return NULL;
+    }
+    m->data = (double **)matrix_storage_alloc(row_bytes);
+    if (m->data == NULL) {
+        perror("Failed to allocate memory for data rows");
+        free(m);
+        return NULL;
+    }
+    matrix_storage_borrow(m->data);
+    m->rows = r;
+    m->cols = c;
+    for (size_t i = 0; i < r; i++) {
+        m->data[i] = block + i * c;
     }
     return m;
 }
 
 void dealloc_float_matrix(FloatMatrix *m) {
     if (m == NULL) return;
-    for (int i = 0; i < m->rows; i++) {
-        free(m->data[i]);
+    double *block = m->data[0];
+    if (matrix_storage_release(m->data)) {
+        free(block);
     }
-    free(m->data);
     free(m);
 }
 
+/* New handle on m's storage: O(1), no element copy. */
+FloatMatrix* share_float_matrix(FloatMatrix *m) {
+    FloatMatrix *handle = (FloatMatrix *)malloc(sizeof(FloatMatrix));
+    if (handle == NULL) {
+        perror("Failed to allocate memory for FloatMatrix");
+        return NULL;
+    }
+    matrix_storage_retain(m->data);
+    *handle = *m;
+    return handle;
+}
+
+/* Copies m's elements into storage of its own if another handle shares them. */
+int float_make_writable(FloatMatrix *m) {
+    if (!matrix_storage_shared(m->data)) {
+        return 0;
+    }
+    FloatMatrix *copy = create_float_matrix(m->rows, m->cols);
+    if (copy == NULL) {
+        return -1;
+    }
+    memcpy(copy->data[0], m->data[0], m->rows * m->cols * sizeof(double));
+
+    double **shared = m->data;
+    double *shared_block = shared[0];
+    m->data = copy->data;
+    free(copy);
+    if (matrix_storage_release(shared)) {
+        free(shared_block);
+    }
+    return 0;
+}
+
 void init_float_zero(FloatMatrix *m) {
-    for (int i = 0; i < m->rows; i++) {
-        for (int j = 0; j < m->cols; j++) {
+    if (float_make_writable(m) != 0) return;
+    for (size_t i = 0; i < m->rows; i++) {
+        for (size_t j = 0; j < m->cols; j++) {
             m->data[i][j] = 0.0;
         }
     }
 }
 
 void float_matrix_print(FloatMatrix *m) {
-    for (int i = 0; i < m->rows; i++) {
-        for (int j = 0; j < m->cols; j++) {
+    for (size_t i = 0; i < m->rows; i++) {
+        for (size_t j = 0; j < m->cols; j++) {
             printf("%8.4f ", m->data[i][j]);
         }
         printf("\n");
@@ -66,14 +150,23 @@ void float_matrix_print(FloatMatrix *m) {
 }
 
 
+/* Wall-clock seconds; falls back to CPU time when built without OpenMP. */
+double float_wall_seconds(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
 FloatMatrix* int_matrix_to_float(Matrix *m) {
     if (m == NULL) return NULL;
 
     FloatMatrix *fm = create_float_matrix(m->rows, m->cols);
     if (fm == NULL) return NULL;
 
-    for (int i = 0; i < m->rows; i++) {
-        for (int j = 0; j < m->cols; j++) {
+    for (size_t i = 0; i < m->rows; i++) {
+        for (size_t j = 0; j < m->cols; j++) {
             fm->data[i][j] = (double)m->data[i][j];
         }
     }
@@ -84,13 +177,11 @@ FloatMatrix* int_matrix_to_float(Matrix *m) {
 Matrix* float_matrix_to_int(FloatMatrix *m) {
     if (m == NULL) return NULL;
 
-    extern Matrix* create_matrix(int r, int c);
-
     Matrix *im = create_matrix(m->rows, m->cols);
     if (im == NULL) return NULL;
 
-    for (int i = 0; i < m->rows; i++) {
-        for (int j = 0; j < m->cols; j++) {
+    for (size_t i = 0; i < m->rows; i++) {
+        for (size_t j = 0; j < m->cols; j++) {
             im->data[i][j] = (int)round(m->data[i][j]);
         }
     }
@@ -98,158 +189,640 @@ Matrix* float_matrix_to_int(FloatMatrix *m) {
     return im;
 }
 
-double float_determinant(FloatMatrix *m) {
-    if (m->rows != m->cols) {
-        printf("Determinant undefined for non-square matrices\n");
-        return 0.0;
+FloatMatrix* float_addition(FloatMatrix *A, FloatMatrix *B) {
+    if (A->rows != B->rows || A->cols != B->cols) {
+        printf("Needs to be the same dimensions\n");
+        return NULL;
+    }
+
+    FloatMatrix *C = create_float_matrix(A->rows, A->cols);
+    if (C == NULL) {
+        return NULL;
     }
 
-    int n = m->rows;
+    for (size_t i = 0; i < A->rows; i++) {
+        for (size_t j = 0; j < A->cols; j++) {
+            C->data[i][j] = A->data[i][j] + B->data[i][j];
+        }
+    }
+    return C;
+}
 
-    if (n == 1) {
-        return m->data[0][0];
+FloatMatrix* float_scalar_multiply(FloatMatrix *m, double scalar) {
+    FloatMatrix *result = create_float_matrix(m->rows, m->cols);
+    if (result == NULL) {
+        return NULL;
     }
 
-    if (n == 2) {
-        return (m->data[0][0] * m->data[1][1]) - (m->data[0][1] * m->data[1][0]);
+    for (size_t i = 0; i < m->rows; i++) {
+        for (size_t j = 0; j < m->cols; j++) {
+            result->data[i][j] = m->data[i][j] * scalar;
+        }
     }
-    double det = 0.0;
+    return result;
+}
 
-    for (int col = 0; col < n; col++) {
-        FloatMatrix *submatrix = create_float_matrix(n - 1, n - 1);
-        if (submatrix == NULL) {
-            return 0.0;
+/*
+ * Classic O(count^3) matrix-chain DP over the dimension sequence. Fills
+ * split[i * count + j] with the best split point of the product i..j and
+ * returns the multiply-add count of the chosen order, or -1 on failure.
+ */
+static double chain_plan(FloatMatrix **matrices, size_t count, size_t *split) {
+    for (size_t t = 0; t + 1 < count; t++) {
+        if (matrices[t]->cols != matrices[t + 1]->rows) {
+            printf("Cannot multiply chain: M%zu.cols (%zu) != M%zu.rows (%zu)\n",
+                   t, matrices[t]->cols, t + 1, matrices[t + 1]->rows);
+            return -1.0;
         }
+    }
 
-        for (int i = 1; i < n; i++) {
-            int sub_j = 0;
-            for (int j = 0; j < n; j++) {
-                if (j != col) {
-                    submatrix->data[i-1][sub_j] = m->data[i][j];
-                    sub_j++;
+    double *cost = (double *)malloc(count * count * sizeof(double));
+    if (cost == NULL) {
+        perror("Failed to allocate chain cost table");
+        return -1.0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        cost[i * count + i] = 0.0;
+    }
+    for (size_t length = 2; length <= count; length++) {
+        for (size_t i = 0; i + length <= count; i++) {
+            size_t j = i + length - 1;
+            cost[i * count + j] = -1.0;
+            for (size_t k = i; k < j; k++) {
+                double c = cost[i * count + k] + cost[(k + 1) * count + j] +
+                           (double)matrices[i]->rows * (double)matrices[k]->cols *
+                           (double)matrices[j]->cols;
+                if (cost[i * count + j] < 0.0 || c < cost[i * count + j]) {
+                    cost[i * count + j] = c;
+                    split[i * count + j] = k;
                 }
             }
         }
+    }
 
-        // Calculate cofactor
-        double sign = (col % 2 == 0) ? 1.0 : -1.0;
-        det += sign * m->data[0][col] * float_determinant(submatrix);
+    double best = cost[count - 1];
+    free(cost);
+    return best;
+}
 
-        dealloc_float_matrix(submatrix);
+/* One product of the plan; operands >= 0 are steps, < 0 encode matrix -(x + 1). */
+typedef struct ChainStep {
+    size_t first;
+    size_t last;
+    long left;
+    long right;
+} ChainStep;
+
+static long chain_schedule(const size_t *split, size_t count, size_t i, size_t j,
+                           ChainStep *steps, size_t *step_count) {
+    if (i == j) {
+        return -(long)i - 1;
     }
-    return det;
+    size_t k = split[i * count + j];
+    long left = chain_schedule(split, count, i, k, steps, step_count);
+    long right = chain_schedule(split, count, k + 1, j, steps, step_count);
+    steps[*step_count].first = i;
+    steps[*step_count].last = j;
+    steps[*step_count].left = left;
+    steps[*step_count].right = right;
+    return (long)(*step_count)++;
 }
 
+/*
+ * Product of matrices[0] * ... * matrices[count - 1] in the FLOP-optimal
+ * parenthesization. All intermediates are allocated before any multiply
+ * runs, then the plan executes in post-order through the blocked kernel.
+ */
+FloatMatrix* float_multiply_chain(FloatMatrix **matrices, size_t count) {
+    if (count == 0) {
+        printf("Cannot multiply an empty chain\n");
+        return NULL;
+    }
+    if (count == 1) {
+        return float_scalar_multiply(matrices[0], 1.0);
+    }
 
-FloatMatrix* float_multiply_matrix(FloatMatrix *A, FloatMatrix *B) {
-    if (A->cols != B->rows) {
-        printf("Cannot multiply: A.cols (%d) != B.rows (%d)\n", A->cols, B->rows);
+    size_t *split = (size_t *)malloc(count * count * sizeof(size_t));
+    ChainStep *steps = (ChainStep *)malloc((count - 1) * sizeof(ChainStep));
+    FloatMatrix **results = (FloatMatrix **)calloc(count - 1, sizeof(FloatMatrix *));
+    if (split == NULL || steps == NULL || results == NULL) {
+        perror("Failed to allocate chain plan");
+        free(split);
+        free(steps);
+        free(results);
         return NULL;
     }
 
-    FloatMatrix *C = create_float_matrix(A->rows, B->cols);
-    if (C == NULL) {
+    int ok = chain_plan(matrices, count, split) >= 0.0;
+    size_t step_count = 0;
+    if (ok) {
+        chain_schedule(split, count, 0, count - 1, steps, &step_count);
+        for (size_t s = 0; s < step_count && ok; s++) {
+            results[s] = create_float_matrix(matrices[steps[s].first]->rows,
+                                             matrices[steps[s].last]->cols);
+            ok = results[s] != NULL;
+        }
+    }
+
+    for (size_t s = 0; s < step_count && ok; s++) {
+        FloatMatrix *A = steps[s].left < 0 ? matrices[-steps[s].left - 1] : results[steps[s].left];
+        FloatMatrix *B = steps[s].right < 0 ? matrices[-steps[s].right - 1] : results[steps[s].right];
+        init_float_zero(results[s]);
+        float_gemm_kernel(A->rows, B->cols, A->cols, 1.0,
+                          A->data[0], A->cols, B->data[0], B->cols,
+                          results[s]->data[0], results[s]->cols);
+    }
+
+    FloatMatrix *product = ok ? results[step_count - 1] : NULL;
+    for (size_t s = 0; s + 1 < count; s++) {
+        if (results[s] != product) {
+            dealloc_float_matrix(results[s]);
+        }
+    }
+    free(split);
+    free(steps);
+    free(results);
+    return product;
+}
+
+static void print_chain_order(const size_t *split, size_t count, size_t i, size_t j) {
+    if (i == j) {
+        printf("M%zu", i);
+        return;
+    }
+    printf("(");
+    print_chain_order(split, count, i, split[i * count + j]);
+    printf(" ");
+    print_chain_order(split, count, split[i * count + j] + 1, j);
+    printf(")");
+}
+
+void float_chain_print_order(FloatMatrix **matrices, size_t count) {
+    if (count == 0) return;
+    size_t *split = (size_t *)malloc(count * count * sizeof(size_t));
+    if (split == NULL) return;
+
+    double best = chain_plan(matrices, count, split);
+    if (best >= 0.0) {
+        double left_to_right = 0.0;
+        for (size_t t = 1; t < count; t++) {
+            left_to_right += (double)matrices[0]->rows * (double)matrices[t]->rows *
+                             (double)matrices[t]->cols;
+        }
+        print_chain_order(split, count, 0, count - 1);
+        printf("\nMultiply-adds: %.0f (left to right: %.0f)\n", best, left_to_right);
+    }
+    free(split);
+}
+
+/*
+ * C = X^T X (or (X - mean)^T (X - mean) when center is set) for an n x p
+ * X, computing only the upper triangle. Pairs of column blocks I <= J are
+ * independent output tiles and are shared out across threads; each thread
+ * packs a row panel of columns I and J (centering on the fly) and
+ * accumulates P_I^T P_J into its tile. With mirror set the lower triangle
+ * is filled from the upper one, otherwise it is left as zeros.
+ */
+FloatMatrix* float_syrk(FloatMatrix *X, int center, int mirror) {
+    size_t n = X->rows, p = X->cols;
+    const FloatTuning *tuning = float_tuning();
+    size_t bs = tuning->syrk_block, rb = FLOAT_SYRK_ROWS;
+    FloatMatrix *C = create_float_matrix(p, p);
+    double *means = (double *)calloc(p, sizeof(double));
+    if (C == NULL || means == NULL) {
+        dealloc_float_matrix(C);
+        free(means);
         return NULL;
     }
+    init_float_zero(C);
 
-    for (int i = 0; i < A->rows; i++) {
-        for (int j = 0; j < B->cols; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < A->cols; k++) {
-                sum += A->data[i][k] * B->data[k][j];
+    if (center) {
+        for (size_t r = 0; r < n; r++) {
+            for (size_t j = 0; j < p; j++) {
+                means[j] += X->data[r][j];
+            }
+        }
+        for (size_t j = 0; j < p; j++) {
+            means[j] /= (double)n;
+        }
+    }
+
+    long nb = (long)((p + bs - 1) / bs);
+    long pairs = nb * (nb + 1) / 2;
+    int parallel = (double)n * (double)p * (double)p / 2.0 >= tuning->parallel_threshold;
+    int failed = 0;
+
+    #pragma omp parallel if(parallel)
+    {
+        double *panel_i = (double *)malloc(rb * bs * sizeof(double));
+        double *panel_j = (double *)malloc(rb * bs * sizeof(double));
+        if (panel_i == NULL || panel_j == NULL) {
+            #pragma omp atomic write
+            failed = 1;
+        }
+
+        #pragma omp for schedule(dynamic)
+        for (long pair = 0; pair < pairs; pair++) {
+            if (panel_i == NULL || panel_j == NULL) continue;
+            long bi = 0, remaining = pair;
+            while (remaining >= nb - bi) {
+                remaining -= nb - bi;
+                bi++;
+            }
+            long bj = bi + remaining;
+
+            size_t i0 = (size_t)bi * bs, j0 = (size_t)bj * bs;
+            size_t ni = (i0 + bs < p) ? bs : p - i0;
+            size_t nj = (j0 + bs < p) ? bs : p - j0;
+
+            for (size_t r0 = 0; r0 < n; r0 += rb) {
+                size_t nr = (r0 + rb < n) ? rb : n - r0;
+                for (size_t r = 0; r < nr; r++) {
+                    const double *x = X->data[r0 + r];
+                    for (size_t i = 0; i < ni; i++) panel_i[r * ni + i] = x[i0 + i] - means[i0 + i];
+                    for (size_t j = 0; j < nj; j++) panel_j[r * nj + j] = x[j0 + j] - means[j0 + j];
+                }
+                for (size_t r = 0; r < nr; r++) {
+                    const double *pi = panel_i + r * ni, *pj = panel_j + r * nj;
+                    for (size_t i = 0; i < ni; i++) {
+                        double a = pi[i];
+                        double *c_row = C->data[i0 + i] + j0;
+                        size_t j_start = (bi == bj) ? i : 0;
+                        for (size_t j = j_start; j < nj; j++) {
+                            c_row[j] += a * pj[j];
+                        }
+                    }
+                }
             }
-            C->data[i][j] = sum;
         }
+
+        free(panel_i);
+        free(panel_j);
     }
 
+    free(means);
+    if (failed) {
+        perror("Failed to allocate SYRK panels");
+        dealloc_float_matrix(C);
+        return NULL;
+    }
+
+    if (mirror) {
+        for (size_t i = 1; i < p; i++) {
+            for (size_t j = 0; j < i; j++) {
+                C->data[i][j] = C->data[j][i];
+            }
+        }
+    }
     return C;
 }
 
-FloatMatrix* float_matrix_inverse(FloatMatrix *m) {
-    if (m->rows != m->cols) {
-        printf("Cannot invert non-square matrix\n");
+/* Sample covariance of the columns of X (rows are observations). */
+FloatMatrix* float_covariance(FloatMatrix *X) {
+    if (X->rows < 2) {
+        printf("Covariance needs at least two observations\n");
+        return NULL;
+    }
+    FloatMatrix *C = float_syrk(X, 1, 1);
+    if (C == NULL) {
         return NULL;
     }
+    double scale = 1.0 / (double)(X->rows - 1);
+    for (size_t i = 0; i < C->rows * C->cols; i++) {
+        C->data[0][i] *= scale;
+    }
+    return C;
+}
+
+/*
+ * O(n^3) via the tiled LU, sign * prod(diag U). No singularity cutoff is
+ * applied: tiny pivots still give their (tiny) product, and only an
+ * exactly zero pivot column yields 0.
+ */
+double float_determinant(FloatMatrix *m) {
+    if (m->rows != m->cols) {
+        printf("Determinant undefined for non-square matrices\n");
+        return 0.0;
+    }
 
-    int n = m->rows;
+    size_t n = m->rows;
 
-    double det = float_determinant(m);
-    if (fabs(det) < 1e-10) {
-        printf("Matrix is singular (determinant ≈ 0), cannot be inverted\n");
-        printf("Determinant: %.10e\n", det);
-        return NULL;
+    if (n == 1) {
+        return m->data[0][0];
     }
 
-    FloatMatrix *augmented = create_float_matrix(n, 2 * n);
-    if (augmented == NULL) {
-        return NULL;
+    if (n == 2) {
+        return (m->data[0][0] * m->data[1][1]) - (m->data[0][1] * m->data[1][0]);
+    }
+
+    FloatMatrix *lu = create_float_matrix(n, n);
+    size_t *pivots = (size_t *)malloc(n * sizeof(size_t));
+    if (lu == NULL || pivots == NULL) {
+        dealloc_float_matrix(lu);
+        free(pivots);
+        return 0.0;
     }
+    memcpy(lu->data[0], m->data[0], n * n * sizeof(double));
 
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            augmented->data[i][j] = m->data[i][j];
+    int sign;
+    double det = 0.0;
+    if (float_lu_decompose_tol(lu->data[0], n, pivots, &sign, 0.0) == 0) {
+        det = (double)sign;
+        for (size_t i = 0; i < n; i++) {
+            det *= lu->data[i][i];
         }
     }
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            augmented->data[i][n + j] = (i == j) ? 1.0 : 0.0;
+
+    dealloc_float_matrix(lu);
+    free(pivots);
+    return det;
+}
+
+
+/*
+ * C += alpha * A * B on raw row-major buffers with leading dimensions lda/ldb/ldc.
+ * The i-k-j order inside each block keeps the innermost loop streaming
+ * along rows of B and C, and row blocks are split across threads.
+ */
+void float_gemm_kernel(size_t m, size_t n, size_t k, double alpha,
+                       const double *A, size_t lda,
+                       const double *B, size_t ldb,
+                       double *C, size_t ldc) {
+    const FloatTuning *tuning = float_tuning();
+    size_t bm = tuning->gemm_block_m;
+    size_t bn = tuning->gemm_block_n;
+    size_t bk = tuning->gemm_block_k;
+    long row_blocks = (long)((m + bm - 1) / bm);
+    int parallel = (double)m * (double)n * (double)k >= tuning->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long rb = 0; rb < row_blocks; rb++) {
+        size_t i0 = (size_t)rb * bm;
+        size_t i1 = (i0 + bm < m) ? i0 + bm : m;
+        for (size_t p0 = 0; p0 < k; p0 += bk) {
+            size_t p1 = (p0 + bk < k) ? p0 + bk : k;
+            for (size_t j0 = 0; j0 < n; j0 += bn) {
+                size_t j1 = (j0 + bn < n) ? j0 + bn : n;
+                for (size_t i = i0; i < i1; i++) {
+                    double *c_row = C + i * ldc;
+                    for (size_t p = p0; p < p1; p++) {
+                        double a = alpha * A[i * lda + p];
+                        const double *b_row = B + p * ldb;
+                        for (size_t j = j0; j < j1; j++) {
+                            c_row[j] += a * b_row[j];
+                        }
+                    }
+                }
+            }
         }
     }
+}
 
-    for (int col = 0; col < n; col++) {
-        int pivot_row = col;
-        double max_val = fabs(augmented->data[col][col]);
+/*
+ * C += alpha * A^T * B, where A is stored k x m (so lda >= m) and B is k x n.
+ * Both operands are still read along their rows: for each p the row of A
+ * supplies one scalar per row of C and the row of B is streamed into it.
+ */
+void float_gemm_kernel_tn(size_t m, size_t n, size_t k, double alpha,
+                          const double *A, size_t lda,
+                          const double *B, size_t ldb,
+                          double *C, size_t ldc) {
+    const FloatTuning *tuning = float_tuning();
+    size_t bm = tuning->gemm_block_m;
+    size_t bn = tuning->gemm_block_n;
+    size_t bk = tuning->gemm_block_k;
+    long row_blocks = (long)((m + bm - 1) / bm);
+    int parallel = (double)m * (double)n * (double)k >= tuning->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long rb = 0; rb < row_blocks; rb++) {
+        size_t i0 = (size_t)rb * bm;
+        size_t i1 = (i0 + bm < m) ? i0 + bm : m;
+        for (size_t p0 = 0; p0 < k; p0 += bk) {
+            size_t p1 = (p0 + bk < k) ? p0 + bk : k;
+            for (size_t j0 = 0; j0 < n; j0 += bn) {
+                size_t j1 = (j0 + bn < n) ? j0 + bn : n;
+                for (size_t p = p0; p < p1; p++) {
+                    const double *a_row = A + p * lda;
+                    const double *b_row = B + p * ldb;
+                    for (size_t i = i0; i < i1; i++) {
+                        double a = alpha * a_row[i];
+                        double *c_row = C + i * ldc;
+                        #pragma omp simd
+                        for (size_t j = j0; j < j1; j++) {
+                            c_row[j] += a * b_row[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
 
-        for (int i = col + 1; i < n; i++) {
-            double abs_val = fabs(augmented->data[i][col]);
-            if (abs_val > max_val) {
-                max_val = abs_val;
-                pivot_row = i;
+/*
+ * C += alpha * A * B^T, where A is m x k and B is stored n x k. Each
+ * element is a dot product of two rows; a block of B's rows is reused
+ * across a block of A's rows while it is still in cache.
+ */
+void float_gemm_kernel_nt(size_t m, size_t n, size_t k, double alpha,
+                          const double *A, size_t lda,
+                          const double *B, size_t ldb,
+                          double *C, size_t ldc) {
+    const FloatTuning *tuning = float_tuning();
+    size_t bm = tuning->gemm_block_m;
+    size_t bk = tuning->gemm_block_k;
+    long row_blocks = (long)((m + bm - 1) / bm);
+    int parallel = (double)m * (double)n * (double)k >= tuning->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long rb = 0; rb < row_blocks; rb++) {
+        size_t i0 = (size_t)rb * bm;
+        size_t i1 = (i0 + bm < m) ? i0 + bm : m;
+        for (size_t j0 = 0; j0 < n; j0 += bm) {
+            size_t j1 = (j0 + bm < n) ? j0 + bm : n;
+            for (size_t p0 = 0; p0 < k; p0 += bk) {
+                size_t p1 = (p0 + bk < k) ? p0 + bk : k;
+                for (size_t i = i0; i < i1; i++) {
+                    const double *a_row = A + i * lda;
+                    double *c_row = C + i * ldc;
+                    for (size_t j = j0; j < j1; j++) {
+                        const double *b_row = B + j * ldb;
+                        double sum = 0.0;
+                        #pragma omp simd reduction(+:sum)
+                        for (size_t p = p0; p < p1; p++) {
+                            sum += a_row[p] * b_row[p];
+                        }
+                        c_row[j] += alpha * sum;
+                    }
+                }
             }
         }
+    }
+}
 
-        if (fabs(augmented->data[pivot_row][col]) < 1e-10) {
-            printf("Matrix is singular, cannot be inverted\n");
-            dealloc_float_matrix(augmented);
-            return NULL;
+FloatMatrix* float_multiply_matrix(FloatMatrix *A, FloatMatrix *B) {
+    if (A->cols != B->rows) {
+        printf("Cannot multiply: A.cols (%zu) != B.rows (%zu)\n", A->cols, B->rows);
+        return NULL;
+    }
+
+    FloatMatrix *C = create_float_matrix(A->rows, B->cols);
+    if (C == NULL) {
+        return NULL;
+    }
+
+    // Row vector or column vector operands go through the GEMV kernels,
+    // an outer product (shared dimension 1) through the rank-1 update
+    if (A->rows == 1) {
+        float_gemv_t(B, A->data[0], C->data[0]);
+        return C;
+    }
+    if (B->cols == 1) {
+        float_gemv(A, B->data[0], C->data[0]);
+        return C;
+    }
+    if (A->cols == 1) {
+        init_float_zero(C);
+        float_ger(C, 1.0, A->data[0], B->data[0]);
+        return C;
+    }
+
+    init_float_zero(C);
+    float_gemm_kernel(A->rows, B->cols, A->cols, 1.0,
+                      A->data[0], A->cols,
+                      B->data[0], B->cols,
+                      C->data[0], C->cols);
+
+    return C;
+}
+
+/* y = A x for an m x n A; each row is one SIMD dot product, rows split across threads. */
+void float_gemv(FloatMatrix *A, const double *x, double *y) {
+    long m = (long)A->rows;
+    size_t n = A->cols;
+    int parallel = (double)A->rows * (double)n >= float_tuning()->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long i = 0; i < m; i++) {
+        const double *a_row = A->data[i];
+        double sum = 0.0;
+        #pragma omp simd reduction(+:sum)
+        for (size_t j = 0; j < n; j++) {
+            sum += a_row[j] * x[j];
         }
+        y[i] = sum;
+    }
+}
 
-        if (pivot_row != col) {
-            for (int j = 0; j < 2 * n; j++) {
-                double temp = augmented->data[col][j];
-                augmented->data[col][j] = augmented->data[pivot_row][j];
-                augmented->data[pivot_row][j] = temp;
+/*
+ * y = x^T A for an m x n A. Threads own disjoint column ranges of y and
+ * stream every row of A across their range, so A is read row-major once.
+ */
+void float_gemv_t(FloatMatrix *A, const double *x, double *y) {
+    size_t m = A->rows, n = A->cols;
+    const FloatTuning *tuning = float_tuning();
+    size_t bn = tuning->gemm_block_n;
+    long col_blocks = (long)((n + bn - 1) / bn);
+    int parallel = col_blocks > 1 && (double)m * (double)n >= tuning->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long cb = 0; cb < col_blocks; cb++) {
+        size_t j0 = (size_t)cb * bn;
+        size_t j1 = (j0 + bn < n) ? j0 + bn : n;
+        for (size_t j = j0; j < j1; j++) {
+            y[j] = 0.0;
+        }
+        for (size_t i = 0; i < m; i++) {
+            double xi = x[i];
+            const double *a_row = A->data[i];
+            #pragma omp simd
+            for (size_t j = j0; j < j1; j++) {
+                y[j] += xi * a_row[j];
             }
         }
+    }
+}
 
-        double pivot = augmented->data[col][col];
-        for (int j = 0; j < 2 * n; j++) {
-            augmented->data[col][j] = augmented->data[col][j] / pivot;
+/* Rank-1 update A += alpha * x y^T, rows split across threads. */
+void float_ger(FloatMatrix *A, double alpha, const double *x, const double *y) {
+    if (float_make_writable(A) != 0) return;
+    long m = (long)A->rows;
+    size_t n = A->cols;
+    int parallel = (double)A->rows * (double)n >= float_tuning()->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long i = 0; i < m; i++) {
+        double scaled = alpha * x[i];
+        double *a_row = A->data[i];
+        #pragma omp simd
+        for (size_t j = 0; j < n; j++) {
+            a_row[j] += scaled * y[j];
         }
+    }
+}
 
-        for (int i = 0; i < n; i++) {
-            if (i != col) {
-                double factor = augmented->data[i][col];
-                for (int j = 0; j < 2 * n; j++) {
-                    augmented->data[i][j] = augmented->data[i][j] - (factor * augmented->data[col][j]);
+/*
+ * Out-of-place transpose in square tiles, so both the reads from m and the
+ * writes to the result stay within a few cache lines per row. Row tiles
+ * of m are split across threads.
+ */
+FloatMatrix* float_transpose(FloatMatrix *m) {
+    FloatMatrix *result = create_float_matrix(m->cols, m->rows);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    const FloatTuning *tuning = float_tuning();
+    size_t bs = tuning->transpose_block;
+    size_t rows = m->rows, cols = m->cols;
+    long row_blocks = (long)((rows + bs - 1) / bs);
+    int parallel = (double)rows * (double)cols >= tuning->parallel_threshold;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (long rb = 0; rb < row_blocks; rb++) {
+        size_t i0 = (size_t)rb * bs;
+        size_t i1 = (i0 + bs < rows) ? i0 + bs : rows;
+        for (size_t j0 = 0; j0 < cols; j0 += bs) {
+            size_t j1 = (j0 + bs < cols) ? j0 + bs : cols;
+            for (size_t i = i0; i < i1; i++) {
+                for (size_t j = j0; j < j1; j++) {
+                    result->data[j][i] = m->data[i][j];
                 }
             }
         }
     }
+    return result;
+}
+
+/* Factors once with the tiled LU, then solves against the identity. */
+FloatMatrix* float_matrix_inverse(FloatMatrix *m) {
+    if (m->rows != m->cols) {
+        printf("Cannot invert non-square matrix\n");
+        return NULL;
+    }
+
+    size_t n = m->rows;
+
+    FloatLU *lu = float_lu_factor(m);
+    if (lu == NULL) {
+        printf("Matrix is singular (determinant ≈ 0), cannot be inverted\n");
+        return NULL;
+    }
 
     FloatMatrix *inverse = create_float_matrix(n, n);
     if (inverse == NULL) {
-        dealloc_float_matrix(augmented);
+        dealloc_float_lu(lu);
         return NULL;
     }
 
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            inverse->data[i][j] = augmented->data[i][n + j];
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            inverse->data[i][j] = (i == j) ? 1.0 : 0.0;
         }
     }
+    float_lu_solve_in_place(lu, inverse);
 
-    dealloc_float_matrix(augmented);
+    dealloc_float_lu(lu);
     return inverse;
 }
 
@@ -267,6 +840,14 @@ void test_float_determinant() {
     double det = float_determinant(m);
     printf("Determinant: %.2f (expected: -306.00)\n", det);
 
+    // Tiny but nonzero pivots are not treated as singular
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            m->data[i][j] = i == j ? 1e-11 : 0.0;
+        }
+    }
+    printf("Determinant of 1e-11 I3: %.2e (expected: 1.00e-33)\n", float_determinant(m));
+
     dealloc_float_matrix(m);
 }
 
@@ -309,6 +890,319 @@ void test_float_inverse() {
 
     dealloc_float_matrix(m);
 }
+void test_float_multiply_blocked() {
+    printf("\n=== Testing Blocked FloatMatrix Multiply ===\n");
+
+    // Odd sizes so every block loop has a ragged edge
+    size_t m = FLOAT_GEMM_BLOCK_M + 7, k = FLOAT_GEMM_BLOCK_K + 5, n = FLOAT_GEMM_BLOCK_N + 3;
+    FloatMatrix *A = create_float_matrix(m, k);
+    FloatMatrix *B = create_float_matrix(k, n);
+    if (A == NULL || B == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        return;
+    }
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < k; j++) {
+            A->data[i][j] = (double)((i * 7 + j * 3) % 11) - 5.0;
+        }
+    }
+    for (size_t i = 0; i < k; i++) {
+        for (size_t j = 0; j < n; j++) {
+            B->data[i][j] = (double)((i * 5 + j * 2) % 13) - 6.0;
+        }
+    }
+
+    FloatMatrix *C = float_multiply_matrix(A, B);
+    if (C != NULL) {
+        double max_error = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double sum = 0.0;
+                for (size_t p = 0; p < k; p++) {
+                    sum += A->data[i][p] * B->data[p][j];
+                }
+                double error = fabs(sum - C->data[i][j]);
+                if (error > max_error) max_error = error;
+            }
+        }
+        printf("%zux%zu * %zux%zu max error vs naive: %.3e (expected: 0)\n", m, k, k, n, max_error);
+        dealloc_float_matrix(C);
+    }
+
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(B);
+}
+void test_float_multiply_chain() {
+    printf("\n=== Testing Matrix Chain Multiply ===\n");
+
+    // Tall data through narrow projections: order matters a lot here
+    size_t dims[5] = { 300, 12, 250, 6, 200 };
+    FloatMatrix *chain[4];
+    for (size_t t = 0; t < 4; t++) {
+        chain[t] = create_float_matrix(dims[t], dims[t + 1]);
+        if (chain[t] == NULL) {
+            for (size_t u = 0; u < t; u++) dealloc_float_matrix(chain[u]);
+            return;
+        }
+        for (size_t i = 0; i < dims[t]; i++) {
+            for (size_t j = 0; j < dims[t + 1]; j++) {
+                chain[t]->data[i][j] = (double)((i * 3 + j * 5 + t) % 7) - 3.0;
+            }
+        }
+    }
+
+    float_chain_print_order(chain, 4);
+    FloatMatrix *product = float_multiply_chain(chain, 4);
+
+    FloatMatrix *ab = float_multiply_matrix(chain[0], chain[1]);
+    FloatMatrix *abc = ab ? float_multiply_matrix(ab, chain[2]) : NULL;
+    FloatMatrix *abcd = abc ? float_multiply_matrix(abc, chain[3]) : NULL;
+    if (product != NULL && abcd != NULL) {
+        double max_error = 0.0;
+        for (size_t i = 0; i < product->rows * product->cols; i++) {
+            double error = fabs(product->data[0][i] - abcd->data[0][i]);
+            if (error > max_error) max_error = error;
+        }
+        printf("%zux%zu result, max error vs left to right: %.3e (expected: 0)\n",
+               product->rows, product->cols, max_error);
+    }
+
+    dealloc_float_matrix(ab);
+    dealloc_float_matrix(abc);
+    dealloc_float_matrix(abcd);
+    dealloc_float_matrix(product);
+    for (size_t t = 0; t < 4; t++) dealloc_float_matrix(chain[t]);
+}
+
+void test_float_syrk() {
+    printf("\n=== Testing SYRK / Covariance ===\n");
+
+    // Columns span several SYRK blocks so off-diagonal tiles are exercised
+    size_t n = 301, p = 2 * FLOAT_SYRK_BLOCK + 9;
+    FloatMatrix *X = create_float_matrix(n, p);
+    if (X == NULL) return;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < p; j++) {
+            X->data[i][j] = (double)((i * 13 + j * 7 + i * j) % 29) / 29.0 + (double)j * 0.01;
+        }
+    }
+
+    FloatMatrix *gram = float_syrk(X, 0, 1);
+    FloatMatrix *cov = float_covariance(X);
+    if (gram != NULL && cov != NULL) {
+        double gram_error = 0.0, cov_error = 0.0;
+        for (size_t a = 0; a < p; a++) {
+            double mean_a = 0.0;
+            for (size_t r = 0; r < n; r++) mean_a += X->data[r][a];
+            mean_a /= (double)n;
+            for (size_t b = 0; b < p; b++) {
+                double mean_b = 0.0, dot = 0.0, centered = 0.0;
+                for (size_t r = 0; r < n; r++) mean_b += X->data[r][b];
+                mean_b /= (double)n;
+                for (size_t r = 0; r < n; r++) {
+                    dot += X->data[r][a] * X->data[r][b];
+                    centered += (X->data[r][a] - mean_a) * (X->data[r][b] - mean_b);
+                }
+                double ge = fabs(dot - gram->data[a][b]);
+                double ce = fabs(centered / (double)(n - 1) - cov->data[a][b]);
+                if (ge > gram_error) gram_error = ge;
+                if (ce > cov_error) cov_error = ce;
+            }
+        }
+        printf("%zux%zu Gram max error: %.3e (expected: < 1e-9)\n", p, p, gram_error);
+        printf("%zux%zu covariance max error: %.3e (expected: < 1e-12)\n", p, p, cov_error);
+    }
+
+    dealloc_float_matrix(gram);
+    dealloc_float_matrix(cov);
+    dealloc_float_matrix(X);
+}
+
+void test_float_gemv() {
+    printf("\n=== Testing GEMV / GER ===\n");
+
+    size_t m = 70, n = FLOAT_GEMM_BLOCK_N + 33;
+    FloatMatrix *A = create_float_matrix(m, n);
+    FloatMatrix *row = create_float_matrix(1, m);
+    FloatMatrix *col = create_float_matrix(n, 1);
+    if (A == NULL || row == NULL || col == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(row);
+        dealloc_float_matrix(col);
+        return;
+    }
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A->data[i][j] = (double)((i * 7 + j * 3) % 10) - 4.5;
+        }
+        row->data[0][i] = (double)(i % 4) - 1.5;
+    }
+    for (size_t j = 0; j < n; j++) {
+        col->data[j][0] = (double)(j % 5) - 2.0;
+    }
+
+    // 1 x m times m x n and m x n times n x 1 both dispatch to GEMV
+    FloatMatrix *xa = float_multiply_matrix(row, A);
+    FloatMatrix *ax = float_multiply_matrix(A, col);
+    if (xa != NULL && ax != NULL) {
+        double max_error = 0.0;
+        for (size_t j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (size_t i = 0; i < m; i++) sum += row->data[0][i] * A->data[i][j];
+            if (fabs(sum - xa->data[0][j]) > max_error) max_error = fabs(sum - xa->data[0][j]);
+        }
+        for (size_t i = 0; i < m; i++) {
+            double sum = 0.0;
+            for (size_t j = 0; j < n; j++) sum += A->data[i][j] * col->data[j][0];
+            if (fabs(sum - ax->data[i][0]) > max_error) max_error = fabs(sum - ax->data[i][0]);
+        }
+        printf("x^T A and A x max error: %.3e (expected: 0)\n", max_error);
+    }
+
+    // A += 0.5 * row^T col^T, checked against the element-wise formula
+    FloatMatrix *before = share_float_matrix(A);
+    float_ger(A, 0.5, row->data[0], col->data[0]);
+    if (before != NULL) {
+        double max_error = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double expected = before->data[i][j] + 0.5 * row->data[0][i] * col->data[j][0];
+                if (fabs(expected - A->data[i][j]) > max_error) max_error = fabs(expected - A->data[i][j]);
+            }
+        }
+        printf("Rank-1 update max error: %.3e (expected: 0)\n", max_error);
+        dealloc_float_matrix(before);
+    }
+
+    // m x 1 times 1 x n dispatches to the rank-1 update on a zeroed C
+    FloatMatrix *u = float_transpose(row);
+    FloatMatrix *v = float_transpose(col);
+    FloatMatrix *outer = (u != NULL && v != NULL) ? float_multiply_matrix(u, v) : NULL;
+    if (outer != NULL) {
+        double max_error = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double expected = row->data[0][i] * col->data[j][0];
+                if (fabs(expected - outer->data[i][j]) > max_error) max_error = fabs(expected - outer->data[i][j]);
+            }
+        }
+        printf("Outer product u v^T max error: %.3e (expected: 0)\n", max_error);
+    }
+    dealloc_float_matrix(outer);
+    dealloc_float_matrix(u);
+    dealloc_float_matrix(v);
+
+    dealloc_float_matrix(xa);
+    dealloc_float_matrix(ax);
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(row);
+    dealloc_float_matrix(col);
+}
+
+void test_float_gemm_transposed() {
+    printf("\n=== Testing Transposed GEMM Kernels ===\n");
+
+    // Odd sizes so every block loop has a ragged edge
+    size_t m = FLOAT_GEMM_BLOCK_M + 13, n = 97, k = FLOAT_GEMM_BLOCK_K + 29;
+    FloatMatrix *A = create_float_matrix(k, m);
+    FloatMatrix *B = create_float_matrix(k, n);
+    FloatMatrix *C = create_float_matrix(m, n);
+    if (A == NULL || B == NULL || C == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        dealloc_float_matrix(C);
+        return;
+    }
+    for (size_t p = 0; p < k; p++) {
+        for (size_t i = 0; i < m; i++) A->data[p][i] = (double)((p * 5 + i * 3) % 11) - 5.0;
+        for (size_t j = 0; j < n; j++) B->data[p][j] = (double)((p * 2 + j * 7) % 13) - 6.0;
+    }
+    FloatMatrix *At = float_transpose(A);
+    FloatMatrix *Bt = float_transpose(B);
+    FloatMatrix *expected = (At != NULL) ? float_multiply_matrix(At, B) : NULL;
+
+    if (Bt != NULL && expected != NULL) {
+        // A^T B straight from A, then (A^T)(B^T)^T from the explicit transposes
+        init_float_zero(C);
+        float_gemm_kernel_tn(m, n, k, 1.0, A->data[0], m, B->data[0], n, C->data[0], n);
+        double tn_error = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double e = fabs(C->data[i][j] - expected->data[i][j]);
+                if (e > tn_error) tn_error = e;
+            }
+        }
+        init_float_zero(C);
+        float_gemm_kernel_nt(m, n, k, 1.0, At->data[0], k, Bt->data[0], k, C->data[0], n);
+        double nt_error = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double e = fabs(C->data[i][j] - expected->data[i][j]);
+                if (e > nt_error) nt_error = e;
+            }
+        }
+        printf("A^T B max error: %.3e (expected: 0)\n", tn_error);
+        printf("A B^T max error: %.3e (expected: 0)\n", nt_error);
+    }
+
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(B);
+    dealloc_float_matrix(C);
+    dealloc_float_matrix(At);
+    dealloc_float_matrix(Bt);
+    dealloc_float_matrix(expected);
+}
+
+/* Fan-out: four readers share one buffer until one of them writes. */
+void test_float_share() {
+    printf("\n=== Testing FloatMatrix Sharing ===\n");
+
+    FloatMatrix *source = create_float_matrix(64, 64);
+    if (source == NULL) return;
+    for (size_t i = 0; i < 64 * 64; i++) {
+        source->data[0][i] = (double)i;
+    }
+
+    FloatMatrix *readers[4];
+    int shared = 1;
+    for (int r = 0; r < 4; r++) {
+        readers[r] = share_float_matrix(source);
+        if (readers[r] == NULL || readers[r]->data[0] != source->data[0]) shared = 0;
+    }
+    printf("Four readers on one buffer: %s (expected: yes)\n", shared ? "yes" : "no");
+
+    if (readers[2] != NULL) {
+        init_float_zero(readers[2]);
+        printf("Writer copied, source intact: %s (expected: yes)\n",
+               (readers[2]->data[0] != source->data[0] && source->data[5][7] == 5.0 * 64 + 7 &&
+                readers[2]->data[5][7] == 0.0) ? "yes" : "no");
+    }
+
+    dealloc_float_matrix(source);
+    printf("Readers keep the buffer after the source handle is freed: %s (expected: yes)\n",
+           (readers[0] != NULL && readers[0]->data[63][63] == 64.0 * 64 - 1) ? "yes" : "no");
+    for (int r = 0; r < 4; r++) {
+        dealloc_float_matrix(readers[r]);
+    }
+
+    // A view over a caller's array: handles come and go, the array stays the caller's
+    double owned[6] = {1, 2, 3, 4, 5, 6};
+    FloatMatrix *view = float_matrix_view(owned, 2, 3);
+    if (view != NULL) {
+        FloatMatrix *copy = share_float_matrix(view);
+        if (copy != NULL) {
+            float_make_writable(copy);
+            copy->data[1][2] = -6.0;
+            dealloc_float_matrix(copy);
+        }
+        view->data[1][0] = 40.0;
+        dealloc_float_matrix(view);
+        printf("View writes land in the caller's array: %s (expected: yes)\n",
+               (owned[3] == 40.0 && owned[5] == 6.0) ? "yes" : "no");
+    }
+}
+
 #ifndef NO_FLOAT_MAIN
 
 int main() {
@@ -317,6 +1211,12 @@ int main() {
 
     test_float_determinant();
     test_float_inverse();
+    test_float_multiply_blocked();
+    test_float_multiply_chain();
+    test_float_syrk();
+    test_float_gemv();
+    test_float_gemm_transposed();
+    test_float_share();
 
     printf("\n✓ All FloatMatrix tests completed!\n");
     return 0;
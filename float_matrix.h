@@ -2,25 +2,63 @@
 #define FLOAT_MATRIX_H
 
 #include "matrix.h"
+#include "float_tune.h"
 
+/*
+ * Same layout as Matrix: one contiguous row-major block plus row pointers,
+ * with the same reference-counted, copy-on-write storage
+ * (share_float_matrix / float_make_writable).
+ */
 typedef struct FloatMatrix {
-    int rows;
-    int cols;
+    size_t rows;
+    size_t cols;
     double **data;
 } FloatMatrix;
 
-FloatMatrix* create_float_matrix(int r, int c);
+FloatMatrix* create_float_matrix(size_t r, size_t c);
+FloatMatrix* float_matrix_view(double *block, size_t r, size_t c);
 void dealloc_float_matrix(FloatMatrix *m);
 void float_matrix_print(FloatMatrix *m);
 void init_float_zero(FloatMatrix *m);
+double float_wall_seconds(void);
+FloatMatrix* share_float_matrix(FloatMatrix *m);
+int float_make_writable(FloatMatrix *m);
 
 FloatMatrix* int_matrix_to_float(Matrix *m);
 Matrix* float_matrix_to_int(FloatMatrix *m);
+FloatMatrix* float_addition(FloatMatrix *A, FloatMatrix *B);
+FloatMatrix* float_scalar_multiply(FloatMatrix *m, double scalar);
+FloatMatrix* float_transpose(FloatMatrix *m);
 double float_determinant(FloatMatrix *m);
 FloatMatrix* float_matrix_inverse(FloatMatrix *m);
 FloatMatrix* float_multiply_matrix(FloatMatrix *A, FloatMatrix *B);
+FloatMatrix* float_multiply_chain(FloatMatrix **matrices, size_t count);
+void float_chain_print_order(FloatMatrix **matrices, size_t count);
+void float_gemv(FloatMatrix *A, const double *x, double *y);
+void float_gemv_t(FloatMatrix *A, const double *x, double *y);
+void float_ger(FloatMatrix *A, double alpha, const double *x, const double *y);
+FloatMatrix* float_syrk(FloatMatrix *X, int center, int mirror);
+FloatMatrix* float_covariance(FloatMatrix *X);
+void float_gemm_kernel(size_t m, size_t n, size_t k, double alpha,
+                       const double *A, size_t lda,
+                       const double *B, size_t ldb,
+                       double *C, size_t ldc);
+void float_gemm_kernel_tn(size_t m, size_t n, size_t k, double alpha,
+                          const double *A, size_t lda,
+                          const double *B, size_t ldb,
+                          double *C, size_t ldc);
+void float_gemm_kernel_nt(size_t m, size_t n, size_t k, double alpha,
+                          const double *A, size_t lda,
+                          const double *B, size_t ldb,
+                          double *C, size_t ldc);
 
 void test_float_inverse(void);
 void test_float_determinant(void);
+void test_float_multiply_blocked(void);
+void test_float_multiply_chain(void);
+void test_float_syrk(void);
+void test_float_gemv(void);
+void test_float_gemm_transposed(void);
+void test_float_share(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef FLOAT_MLP_H
+#define FLOAT_MLP_H
+
+#include <stdint.h>
+#include "float_matrix.h"
+#include "matrix_random.h"
+#include "float_optim.h"
+
+/* Negative-side slopes used by the LEAKY_RELU and ELU layers. */
+#define FLOAT_MLP_LEAKY_ALPHA 0.01
+#define FLOAT_MLP_ELU_ALPHA 1.0
+
+typedef enum FloatActivation {
+    FLOAT_ACT_LINEAR,
+    FLOAT_ACT_SIGMOID,
+    FLOAT_ACT_TANH,
+    FLOAT_ACT_RELU,
+    FLOAT_ACT_LEAKY_RELU,
+    FLOAT_ACT_ELU,
+    FLOAT_ACT_SWISH,
+    FLOAT_ACT_HARD_SIGMOID,
+    FLOAT_ACT_SOFTMAX
+} FloatActivation;
+
+/*
+ * EXACT evaluates sigmoid, tanh, ELU and swish through libm; FAST uses
+ * the vectorized approximations of activ_func/nn_func.h (error <= 1e-12).
+ */
+typedef enum FloatActivationMode {
+    FLOAT_ACTIVATIONS_EXACT,
+    FLOAT_ACTIVATIONS_FAST
+} FloatActivationMode;
+
+/*
+ * One dense layer A = f(X W + b) over a batch of row vectors. weights is
+ * inputs x outputs so each input row multiplies it directly. weights,
+ * bias and their gradients are views into the network's parameter and
+ * gradient blocks. z, a and delta (dLoss/dz) are max_batch x outputs
+ * workspaces; a batch of B rows uses their first B rows. The backward
+ * pass overwrites z with f'(z).
+ */
+typedef struct FloatLayer {
+    size_t inputs;
+    size_t outputs;
+    FloatActivation activation;
+    FloatMatrix *weights;
+    FloatMatrix *bias;
+    FloatMatrix *weight_grad;
+    FloatMatrix *bias_grad;
+    FloatMatrix *z;
+    FloatMatrix *a;
+    FloatMatrix *delta;
+} FloatLayer;
+
+/*
+ * Multi-layer perceptron. Every buffer a forward pass, backward pass or
+ * update touches is allocated by float_mlp_create, so training performs
+ * no heap allocation. batch_input and batch_target stage the gathered
+ * rows of a shuffled mini-batch; order is the epoch permutation, grown
+ * only when a larger data set comes along.
+ *
+ * All weights and biases live in one 1 x parameter_count block, and their
+ * gradients in a second block of the same layout, each tensor starting on
+ * an 8-double boundary; the padding stays zero. An update is therefore a
+ * single sweep over two contiguous vectors. optimizer, when set, is used
+ * by the training calls in place of plain SGD; the caller owns it.
+ * Networks from float_mlp_wrap have no gradient block (gradients and the
+ * layers' *_grad views are NULL) and only run forward passes.
+ */
+typedef struct FloatMLP {
+    size_t layer_count;
+    FloatLayer *layers;
+    FloatActivationMode activation_mode;
+    size_t max_batch;
+    FloatMatrix *batch_input;
+    FloatMatrix *batch_target;
+    size_t *order;
+    size_t order_capacity;
+    size_t parameter_count;
+    FloatMatrix *parameters;
+    FloatMatrix *gradients;
+    FloatOptimizer *optimizer;
+} FloatMLP;
+
+FloatMLP* float_mlp_create(const size_t *sizes, const FloatActivation *activations,
+                           size_t layer_count, size_t max_batch, uint64_t seed);
+FloatMLP* float_mlp_replica(FloatMLP *model, size_t max_batch);
+FloatMLP* float_mlp_wrap(const size_t *sizes, const FloatActivation *activations,
+                         size_t layer_count, size_t max_batch, double *parameters);
+void dealloc_float_mlp(FloatMLP *mlp);
+void float_mlp_set_activation_mode(FloatMLP *mlp, FloatActivationMode mode);
+int float_mlp_set_optimizer(FloatMLP *mlp, FloatOptimizer *optimizer);
+
+const double* float_mlp_forward_batch(FloatMLP *mlp, const double *inputs, size_t batch);
+double float_mlp_backward_batch(FloatMLP *mlp, const double *inputs, const double *targets,
+                                size_t batch);
+const double* float_mlp_forward(FloatMLP *mlp, const double *input);
+double float_mlp_backward(FloatMLP *mlp, const double *input, const double *target);
+void float_mlp_sgd(FloatMLP *mlp, double learning_rate);
+void float_mlp_update(FloatMLP *mlp, double learning_rate);
+double float_mlp_train_step(FloatMLP *mlp, const double *input, const double *target,
+                            double learning_rate);
+double float_mlp_train_batch(FloatMLP *mlp, const double *inputs, const double *targets,
+                             size_t batch, double learning_rate);
+double float_mlp_train_epoch(FloatMLP *mlp, FloatMatrix *X, FloatMatrix *Y, size_t batch_size,
+                             double learning_rate, MatrixRng *shuffle);
+int float_mlp_shuffle(FloatMLP *mlp, size_t samples, MatrixRng *shuffle);
+int float_mlp_predict(FloatMLP *mlp, FloatMatrix *X, FloatMatrix *out);
+
+int float_softmax(FloatMatrix *logits, FloatMatrix *probs);
+double float_softmax_cross_entropy(FloatMatrix *logits, const size_t *labels, FloatMatrix *grad);
+
+void test_float_mlp_gradients(void);
+void test_float_mlp_training(void);
+void test_float_mlp_batches(void);
+void test_float_mlp_optimizers(void);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef FLOAT_NUMA_H
+#define FLOAT_NUMA_H
+
+#include <stddef.h>
+
+/*
+ * Page placement for FloatMatrix buffers on multi-socket machines. Linux
+ * puts a page on the node of the thread that first writes it, so a buffer
+ * filled by one thread lives on one node and the other sockets read it
+ * remotely.
+ *
+ * FIRST_TOUCH has every OpenMP thread zero the rows a static-scheduled
+ * kernel hands it, so each thread's rows sit on its own node. INTERLEAVE
+ * spreads pages round-robin over all nodes (for buffers without a stable
+ * owner) and falls back to first touch where mbind is unavailable.
+ */
+typedef enum FloatPlacement {
+    FLOAT_PLACEMENT_DEFAULT,
+    FLOAT_PLACEMENT_FIRST_TOUCH,
+    FLOAT_PLACEMENT_INTERLEAVE
+} FloatPlacement;
+
+/* Smaller buffers are left to malloc; they live in cache anyway. */
+#define FLOAT_NUMA_MIN_BYTES (1 << 21)
+
+void float_set_placement(FloatPlacement placement);
+FloatPlacement float_get_placement(void);
+void float_place_rows(double *block, size_t rows, size_t cols);
+int float_numa_nodes(void);
+int float_pin_threads(void);
+void float_unpin_threads(void);
+
+void test_float_placement(void);
+
+#endif
@@ -0,0 +1,459 @@
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "float_matrix.h"
+#include "float_ooc.h"
+
+static double ooc_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static FloatMatrixFile* map_matrix_file(int fd, size_t length, int writable) {
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *mapping = mmap(NULL, length, prot, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        perror("Failed to map matrix file");
+        return NULL;
+    }
+
+    FloatMatrixFile *f = (FloatMatrixFile *)malloc(sizeof(FloatMatrixFile));
+    if (f == NULL) {
+        perror("Failed to allocate memory for FloatMatrixFile");
+        munmap(mapping, length);
+        return NULL;
+    }
+    f->mapping = mapping;
+    f->mapping_size = length;
+    f->writable = writable;
+    f->data = (double *)((char *)mapping + FLOAT_FILE_HEADER_SIZE);
+    return f;
+}
+
+FloatMatrixFile* float_file_create(const char *path, size_t rows, size_t cols) {
+    size_t count, bytes, length;
+    if (rows == 0 || cols == 0) {
+        printf("Matrix dimensions must be positive\n");
+        return NULL;
+    }
+    if (!matrix_size_mul(rows, cols, &count) ||
+        !matrix_size_mul(count, sizeof(double), &bytes) ||
+        bytes > SIZE_MAX - FLOAT_FILE_HEADER_SIZE) {
+        printf("Matrix file of %zu x %zu elements is too large\n", rows, cols);
+        return NULL;
+    }
+    length = bytes + FLOAT_FILE_HEADER_SIZE;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("Failed to create matrix file");
+        return NULL;
+    }
+    if (ftruncate(fd, (off_t)length) != 0) {
+        perror("Failed to size matrix file");
+        close(fd);
+        return NULL;
+    }
+
+    FloatMatrixFile *f = map_matrix_file(fd, length, 1);
+    close(fd);
+    if (f == NULL) {
+        return NULL;
+    }
+
+    uint64_t dims[2] = { (uint64_t)rows, (uint64_t)cols };
+    memcpy(f->mapping, FLOAT_FILE_MAGIC, 8);
+    memcpy((char *)f->mapping + 8, dims, sizeof(dims));
+    f->rows = rows;
+    f->cols = cols;
+    return f;
+}
+
+FloatMatrixFile* float_file_open(const char *path, int writable) {
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open matrix file");
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < FLOAT_FILE_HEADER_SIZE) {
+        printf("Not a matrix file: %s\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    FloatMatrixFile *f = map_matrix_file(fd, (size_t)st.st_size, writable);
+    close(fd);
+    if (f == NULL) {
+        return NULL;
+    }
+
+    uint64_t dims[2];
+    size_t count, bytes;
+    memcpy(dims, (char *)f->mapping + 8, sizeof(dims));
+    if (memcmp(f->mapping, FLOAT_FILE_MAGIC, 8) != 0 ||
+        dims[0] == 0 || dims[1] == 0 ||
+        !matrix_size_mul((size_t)dims[0], (size_t)dims[1], &count) ||
+        !matrix_size_mul(count, sizeof(double), &bytes) ||
+        bytes != f->mapping_size - FLOAT_FILE_HEADER_SIZE) {
+        printf("Corrupt or truncated matrix file: %s\n", path);
+        munmap(f->mapping, f->mapping_size);
+        free(f);
+        return NULL;
+    }
+    f->rows = (size_t)dims[0];
+    f->cols = (size_t)dims[1];
+    return f;
+}
+
+void float_file_close(FloatMatrixFile *f) {
+    if (f == NULL) return;
+    if (f->writable) {
+        msync(f->mapping, f->mapping_size, MS_SYNC);
+    }
+    munmap(f->mapping, f->mapping_size);
+    free(f);
+}
+
+int float_file_save(const char *path, FloatMatrix *m) {
+    FloatMatrixFile *f = float_file_create(path, m->rows, m->cols);
+    if (f == NULL) {
+        return -1;
+    }
+    memcpy(f->data, m->data[0], m->rows * m->cols * sizeof(double));
+    float_file_close(f);
+    return 0;
+}
+
+FloatMatrix* float_file_load(const char *path) {
+    FloatMatrixFile *f = float_file_open(path, 0);
+    if (f == NULL) {
+        return NULL;
+    }
+    FloatMatrix *m = create_float_matrix(f->rows, f->cols);
+    if (m != NULL) {
+        memcpy(m->data[0], f->data, f->rows * f->cols * sizeof(double));
+    }
+    float_file_close(f);
+    return m;
+}
+
+/*
+ * The reader thread walks the same (i, j, k) tile schedule as the compute
+ * loop and fills one of two A/B buffer slots while the other is being
+ * multiplied, so tile I/O overlaps the kernel.
+ */
+typedef struct OocPipeline {
+    FloatMatrixFile *A;
+    FloatMatrixFile *B;
+    size_t tile;
+    size_t m_tiles, n_tiles, k_tiles;
+    size_t steps;
+    double *a_buf[2];
+    double *b_buf[2];
+    int full[2];
+    double io_seconds;
+    double bytes_read;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} OocPipeline;
+
+static void ooc_step_tiles(const OocPipeline *p, size_t step, size_t *ti, size_t *tj, size_t *tk) {
+    *tk = step % p->k_tiles;
+    *tj = (step / p->k_tiles) % p->n_tiles;
+    *ti = step / (p->k_tiles * p->n_tiles);
+}
+
+static size_t ooc_extent(size_t index, size_t tile, size_t dim) {
+    size_t start = index * tile;
+    return (start + tile < dim) ? tile : dim - start;
+}
+
+static double ooc_copy_tile(const FloatMatrixFile *src, size_t r0, size_t c0,
+                            size_t rows, size_t cols, double *dst) {
+    for (size_t r = 0; r < rows; r++) {
+        memcpy(dst + r * cols, src->data + (r0 + r) * src->cols + c0, cols * sizeof(double));
+    }
+    return (double)rows * (double)cols * sizeof(double);
+}
+
+static void* ooc_reader(void *arg) {
+    OocPipeline *p = (OocPipeline *)arg;
+
+    for (size_t step = 0; step < p->steps; step++) {
+        int slot = (int)(step % 2);
+        size_t ti, tj, tk;
+        ooc_step_tiles(p, step, &ti, &tj, &tk);
+
+        pthread_mutex_lock(&p->lock);
+        while (p->full[slot]) {
+            pthread_cond_wait(&p->changed, &p->lock);
+        }
+        pthread_mutex_unlock(&p->lock);
+
+        size_t tm = ooc_extent(ti, p->tile, p->A->rows);
+        size_t tn = ooc_extent(tj, p->tile, p->B->cols);
+        size_t tkk = ooc_extent(tk, p->tile, p->A->cols);
+        double start = ooc_now();
+        double bytes = ooc_copy_tile(p->A, ti * p->tile, tk * p->tile, tm, tkk, p->a_buf[slot]);
+        bytes += ooc_copy_tile(p->B, tk * p->tile, tj * p->tile, tkk, tn, p->b_buf[slot]);
+        double elapsed = ooc_now() - start;
+
+        pthread_mutex_lock(&p->lock);
+        p->full[slot] = 1;
+        p->io_seconds += elapsed;
+        p->bytes_read += bytes;
+        pthread_cond_broadcast(&p->changed);
+        pthread_mutex_unlock(&p->lock);
+    }
+    return NULL;
+}
+
+/*
+ * C = A * B where all three live in matrix files. At most memory_budget
+ * bytes of tile buffers are allocated: two A tiles, two B tiles and one C
+ * tile of tile_size x tile_size doubles. Pages of the mapped files are
+ * clean page cache and stay reclaimable by the kernel.
+ */
+int float_multiply_file(FloatMatrixFile *A, FloatMatrixFile *B, FloatMatrixFile *C,
+                        size_t memory_budget, OocStats *stats) {
+    if (A->cols != B->rows) {
+        printf("Cannot multiply: A.cols (%zu) != B.rows (%zu)\n", A->cols, B->rows);
+        return -1;
+    }
+    if (C->rows != A->rows || C->cols != B->cols || !C->writable) {
+        printf("Output file must be a writable %zu x %zu matrix\n", A->rows, B->cols);
+        return -1;
+    }
+
+    size_t tile = (size_t)sqrt((double)memory_budget / (5.0 * sizeof(double)));
+    tile -= tile % 8;
+    if (tile < 8) {
+        printf("Memory budget of %zu bytes is too small for out-of-core multiply\n", memory_budget);
+        return -1;
+    }
+
+    OocPipeline p;
+    memset(&p, 0, sizeof(p));
+    p.A = A;
+    p.B = B;
+    p.tile = tile;
+    p.m_tiles = (A->rows + tile - 1) / tile;
+    p.n_tiles = (B->cols + tile - 1) / tile;
+    p.k_tiles = (A->cols + tile - 1) / tile;
+    p.steps = p.m_tiles * p.n_tiles * p.k_tiles;
+
+    size_t a_elems = (A->rows < tile ? A->rows : tile) * (A->cols < tile ? A->cols : tile);
+    size_t b_elems = (B->rows < tile ? B->rows : tile) * (B->cols < tile ? B->cols : tile);
+    size_t c_elems = (C->rows < tile ? C->rows : tile) * (C->cols < tile ? C->cols : tile);
+    double *c_buf = (double *)malloc(c_elems * sizeof(double));
+    int ok = c_buf != NULL;
+    for (int s = 0; s < 2; s++) {
+        p.a_buf[s] = (double *)malloc(a_elems * sizeof(double));
+        p.b_buf[s] = (double *)malloc(b_elems * sizeof(double));
+        ok = ok && p.a_buf[s] != NULL && p.b_buf[s] != NULL;
+    }
+    if (!ok) {
+        perror("Failed to allocate tile buffers");
+        free(c_buf);
+        for (int s = 0; s < 2; s++) {
+            free(p.a_buf[s]);
+            free(p.b_buf[s]);
+        }
+        return -1;
+    }
+
+    pthread_mutex_init(&p.lock, NULL);
+    pthread_cond_init(&p.changed, NULL);
+
+    double wall_start = ooc_now();
+    double compute_seconds = 0.0;
+    double bytes_written = 0.0;
+    pthread_t reader;
+    int rc = pthread_create(&reader, NULL, ooc_reader, &p);
+    if (rc != 0) {
+        printf("Failed to start tile reader thread\n");
+    }
+
+    for (size_t step = 0; rc == 0 && step < p.steps; step++) {
+        int slot = (int)(step % 2);
+        size_t ti, tj, tk;
+        ooc_step_tiles(&p, step, &ti, &tj, &tk);
+        size_t tm = ooc_extent(ti, tile, A->rows);
+        size_t tn = ooc_extent(tj, tile, B->cols);
+        size_t tkk = ooc_extent(tk, tile, A->cols);
+
+        pthread_mutex_lock(&p.lock);
+        while (!p.full[slot]) {
+            pthread_cond_wait(&p.changed, &p.lock);
+        }
+        pthread_mutex_unlock(&p.lock);
+
+        if (tk == 0) {
+            memset(c_buf, 0, tm * tn * sizeof(double));
+        }
+        double start = ooc_now();
+        float_gemm_kernel(tm, tn, tkk, 1.0, p.a_buf[slot], tkk, p.b_buf[slot], tn, c_buf, tn);
+        compute_seconds += ooc_now() - start;
+
+        pthread_mutex_lock(&p.lock);
+        p.full[slot] = 0;
+        pthread_cond_broadcast(&p.changed);
+        pthread_mutex_unlock(&p.lock);
+
+        if (tk == p.k_tiles - 1) {
+            for (size_t r = 0; r < tm; r++) {
+                memcpy(C->data + (ti * tile + r) * C->cols + tj * tile,
+                       c_buf + r * tn, tn * sizeof(double));
+            }
+            bytes_written += (double)tm * (double)tn * sizeof(double);
+        }
+    }
+
+    if (rc == 0) {
+        pthread_join(reader, NULL);
+    }
+    double wall_seconds = ooc_now() - wall_start;
+
+    if (stats != NULL) {
+        stats->tile_size = tile;
+        stats->tiles_loaded = p.steps;
+        stats->bytes_read = p.bytes_read;
+        stats->bytes_written = bytes_written;
+        stats->io_seconds = p.io_seconds;
+        stats->compute_seconds = compute_seconds;
+        stats->wall_seconds = wall_seconds;
+        stats->io_gbps = p.io_seconds > 0.0 ? p.bytes_read / p.io_seconds / 1e9 : 0.0;
+        stats->compute_gflops = compute_seconds > 0.0
+            ? 2.0 * (double)A->rows * (double)B->cols * (double)A->cols / compute_seconds / 1e9
+            : 0.0;
+    }
+
+    pthread_cond_destroy(&p.changed);
+    pthread_mutex_destroy(&p.lock);
+    free(c_buf);
+    for (int s = 0; s < 2; s++) {
+        free(p.a_buf[s]);
+        free(p.b_buf[s]);
+    }
+    return rc == 0 ? 0 : -1;
+}
+
+void ooc_stats_print(const OocStats *stats) {
+    printf("Tile size:     %zu (%zu tile pairs streamed)\n", stats->tile_size, stats->tiles_loaded);
+    printf("Read:          %.2f MB in %.4f s (%.2f GB/s)\n",
+           stats->bytes_read / 1e6, stats->io_seconds, stats->io_gbps);
+    printf("Written:       %.2f MB\n", stats->bytes_written / 1e6);
+    printf("Compute:       %.4f s (%.2f GFLOP/s)\n", stats->compute_seconds, stats->compute_gflops);
+    printf("Wall:          %.4f s (I/O + compute = %.4f s)\n",
+           stats->wall_seconds, stats->io_seconds + stats->compute_seconds);
+}
+
+void test_float_file_roundtrip() {
+    printf("\n=== Testing Matrix File Round Trip ===\n");
+
+    FloatMatrix *m = create_float_matrix(3, 4);
+    if (m == NULL) return;
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            m->data[i][j] = (double)i * 10.0 + (double)j + 0.25;
+        }
+    }
+
+    const char *path = "ooc_roundtrip.fmat";
+    FloatMatrix *loaded = NULL;
+    if (float_file_save(path, m) == 0) {
+        loaded = float_file_load(path);
+    }
+    remove(path);
+
+    if (loaded != NULL) {
+        int same = loaded->rows == 3 && loaded->cols == 4 &&
+                   memcmp(loaded->data[0], m->data[0], 12 * sizeof(double)) == 0;
+        printf("Loaded matrix matches saved one: %s (expected: yes)\n", same ? "yes" : "no");
+        dealloc_float_matrix(loaded);
+    }
+    dealloc_float_matrix(m);
+}
+
+void test_float_multiply_file() {
+    printf("\n=== Testing Out-of-Core Multiply ===\n");
+
+    size_t m = 150, k = 130, n = 170;
+    FloatMatrix *A = create_float_matrix(m, k);
+    FloatMatrix *B = create_float_matrix(k, n);
+    if (A == NULL || B == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        return;
+    }
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < k; j++) {
+            A->data[i][j] = (double)((i * 3 + j * 7) % 17) - 8.0;
+        }
+    }
+    for (size_t i = 0; i < k; i++) {
+        for (size_t j = 0; j < n; j++) {
+            B->data[i][j] = (double)((i * 11 + j * 5) % 19) - 9.0;
+        }
+    }
+
+    const char *a_path = "ooc_a.fmat", *b_path = "ooc_b.fmat", *c_path = "ooc_c.fmat";
+    FloatMatrixFile *fa = NULL, *fb = NULL, *fc = NULL;
+    if (float_file_save(a_path, A) == 0 && float_file_save(b_path, B) == 0) {
+        fa = float_file_open(a_path, 0);
+        fb = float_file_open(b_path, 0);
+        fc = float_file_create(c_path, m, n);
+    }
+
+    // 40 KB budget -> 32x32 tiles, so every dimension is split several times
+    OocStats stats;
+    if (fa != NULL && fb != NULL && fc != NULL &&
+        float_multiply_file(fa, fb, fc, 40 * 1024, &stats) == 0) {
+        FloatMatrix *expected = float_multiply_matrix(A, B);
+        if (expected != NULL) {
+            double max_error = 0.0;
+            for (size_t i = 0; i < m * n; i++) {
+                double error = fabs(expected->data[0][i] - fc->data[i]);
+                if (error > max_error) max_error = error;
+            }
+            printf("Max error vs in-memory multiply: %.3e (expected: 0)\n", max_error);
+            dealloc_float_matrix(expected);
+        }
+        ooc_stats_print(&stats);
+    }
+
+    float_file_close(fa);
+    float_file_close(fb);
+    float_file_close(fc);
+    remove(a_path);
+    remove(b_path);
+    remove(c_path);
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(B);
+}
+
+#ifndef NO_OOC_MAIN
+int main() {
+    printf("Out-of-Core FloatMatrix Test\n");
+    printf("============================\n");
+
+    test_float_file_roundtrip();
+    test_float_multiply_file();
+
+    printf("\n✓ All out-of-core tests completed!\n");
+    return 0;
+}
+#endif
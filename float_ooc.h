@@ -0,0 +1,49 @@
+#ifndef FLOAT_OOC_H
+#define FLOAT_OOC_H
+
+#include "float_matrix.h"
+
+/*
+ * Out-of-core FloatMatrix support (POSIX: mmap + pthreads).
+ *
+ * A matrix file is a FLOAT_FILE_HEADER_SIZE byte header (magic, rows, cols)
+ * followed by rows * cols doubles in row-major order.
+ */
+#define FLOAT_FILE_MAGIC "FMATRIX1"
+#define FLOAT_FILE_HEADER_SIZE 64
+
+typedef struct FloatMatrixFile {
+    size_t rows;
+    size_t cols;
+    double *data;        // Row-major elements inside the mapping
+    void *mapping;
+    size_t mapping_size;
+    int writable;
+} FloatMatrixFile;
+
+typedef struct OocStats {
+    size_t tile_size;        // Edge of the square tiles that fit the budget
+    size_t tiles_loaded;     // A/B tile pairs streamed by the reader thread
+    double bytes_read;
+    double bytes_written;
+    double io_seconds;       // Reader thread time spent copying tiles in
+    double compute_seconds;  // Time spent inside the blocked kernel
+    double wall_seconds;
+    double io_gbps;
+    double compute_gflops;
+} OocStats;
+
+FloatMatrixFile* float_file_create(const char *path, size_t rows, size_t cols);
+FloatMatrixFile* float_file_open(const char *path, int writable);
+void float_file_close(FloatMatrixFile *f);
+int float_file_save(const char *path, FloatMatrix *m);
+FloatMatrix* float_file_load(const char *path);
+
+int float_multiply_file(FloatMatrixFile *A, FloatMatrixFile *B, FloatMatrixFile *C,
+                        size_t memory_budget, OocStats *stats);
+void ooc_stats_print(const OocStats *stats);
+
+void test_float_file_roundtrip(void);
+void test_float_multiply_file(void);
+
+#endif
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_optim.h"
+#include "matrix_random.h"
+
+static FloatOptimizer* optimizer_create(FloatOptimizerKind kind, size_t count, double learning_rate,
+                                        int state_vectors) {
+    if (count == 0) {
+        printf("An optimizer needs at least one parameter\n");
+        return NULL;
+    }
+    FloatOptimizer *opt = (FloatOptimizer *)malloc(sizeof(FloatOptimizer));
+    if (opt == NULL) {
+        perror("Failed to allocate memory for FloatOptimizer");
+        return NULL;
+    }
+    opt->kind = kind;
+    opt->count = count;
+    opt->learning_rate = learning_rate;
+    opt->beta1 = 0.0;
+    opt->beta2 = 0.0;
+    opt->epsilon = 0.0;
+    opt->step = 0;
+    opt->first = NULL;
+    opt->second = NULL;
+    if (state_vectors >= 1) {
+        opt->first = create_float_matrix(1, count);
+    }
+    if (state_vectors >= 2) {
+        opt->second = create_float_matrix(1, count);
+    }
+    if ((state_vectors >= 1 && opt->first == NULL) || (state_vectors >= 2 && opt->second == NULL)) {
+        dealloc_float_optimizer(opt);
+        return NULL;
+    }
+    float_optim_reset(opt);
+    return opt;
+}
+
+/*
+ * Rounds a tensor's length up to a whole number of 8-double (64-byte)
+ * blocks, so every tensor of a layer's parameter block starts aligned.
+ */
+size_t float_optim_padded_length(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+/*
+ * Checks that opt (NULL for plain SGD) can drive a parameter block of
+ * count elements; -1 with a message otherwise.
+ */
+int float_optim_fits(const FloatOptimizer *opt, size_t count) {
+    if (opt != NULL && opt->count != count) {
+        printf("Optimizer holds %zu parameters, the model %zu\n", opt->count, count);
+        return -1;
+    }
+    return 0;
+}
+
+/* Plain SGD when momentum is 0, otherwise heavy-ball momentum with a velocity vector. */
+FloatOptimizer* float_optim_sgd(size_t count, double learning_rate, double momentum) {
+    FloatOptimizer *opt = optimizer_create(FLOAT_OPTIM_SGD, count, learning_rate, momentum != 0.0);
+    if (opt != NULL) {
+        opt->beta1 = momentum;
+    }
+    return opt;
+}
+
+FloatOptimizer* float_optim_rmsprop(size_t count, double learning_rate, double decay, double epsilon) {
+    FloatOptimizer *opt = optimizer_create(FLOAT_OPTIM_RMSPROP, count, learning_rate, 1);
+    if (opt != NULL) {
+        opt->beta2 = decay;
+        opt->epsilon = epsilon;
+    }
+    return opt;
+}
+
+FloatOptimizer* float_optim_adam(size_t count, double learning_rate, double beta1, double beta2,
+                                 double epsilon) {
+    FloatOptimizer *opt = optimizer_create(FLOAT_OPTIM_ADAM, count, learning_rate, 2);
+    if (opt != NULL) {
+        opt->beta1 = beta1;
+        opt->beta2 = beta2;
+        opt->epsilon = epsilon;
+    }
+    return opt;
+}
+
+void dealloc_float_optimizer(FloatOptimizer *opt) {
+    if (opt == NULL) return;
+    dealloc_float_matrix(opt->first);
+    dealloc_float_matrix(opt->second);
+    free(opt);
+}
+
+/* Zeroes the state and the step count, as if no update had been made. */
+void float_optim_reset(FloatOptimizer *opt) {
+    opt->step = 0;
+    if (opt->first != NULL) init_float_zero(opt->first);
+    if (opt->second != NULL) init_float_zero(opt->second);
+}
+
+/*
+ * One update of params from grads, both count long. Each optimizer is a
+ * single SIMD sweep that touches every parameter, gradient and state
+ * element once; the sweep is split across threads for large models.
+ */
+void float_optim_step(FloatOptimizer *opt, double *params, const double *grads) {
+    long count = (long)opt->count;
+    int parallel = (double)opt->count >= float_tuning()->parallel_threshold;
+    double lr = opt->learning_rate;
+    double b1 = opt->beta1, b2 = opt->beta2, eps = opt->epsilon;
+    if ((opt->first != NULL && float_make_writable(opt->first) != 0) ||
+        (opt->second != NULL && float_make_writable(opt->second) != 0)) {
+        return;
+    }
+    opt->step++;
+
+    if (opt->kind == FLOAT_OPTIM_SGD && opt->first == NULL) {
+        #pragma omp parallel for simd schedule(static) if(parallel)
+        for (long i = 0; i < count; i++) {
+            params[i] -= lr * grads[i];
+        }
+    } else if (opt->kind == FLOAT_OPTIM_SGD) {
+        double *v = opt->first->data[0];
+        #pragma omp parallel for simd schedule(static) if(parallel)
+        for (long i = 0; i < count; i++) {
+            double velocity = b1 * v[i] + grads[i];
+            v[i] = velocity;
+            params[i] -= lr * velocity;
+        }
+    } else if (opt->kind == FLOAT_OPTIM_RMSPROP) {
+        double *s = opt->first->data[0];
+        #pragma omp parallel for simd schedule(static) if(parallel)
+        for (long i = 0; i < count; i++) {
+            double g = grads[i];
+            double mean_square = b2 * s[i] + (1.0 - b2) * g * g;
+            s[i] = mean_square;
+            params[i] -= lr * g / (sqrt(mean_square) + eps);
+        }
+    } else {
+        double *m = opt->first->data[0];
+        double *v = opt->second->data[0];
+        double c1 = 1.0 / (1.0 - pow(b1, (double)opt->step));
+        double c2 = 1.0 / (1.0 - pow(b2, (double)opt->step));
+        #pragma omp parallel for simd schedule(static) if(parallel)
+        for (long i = 0; i < count; i++) {
+            double g = grads[i];
+            double mean = b1 * m[i] + (1.0 - b1) * g;
+            double variance = b2 * v[i] + (1.0 - b2) * g * g;
+            m[i] = mean;
+            v[i] = variance;
+            params[i] -= lr * (mean * c1) / (sqrt(variance * c2) + eps);
+        }
+    }
+}
+
+/*
+ * One update of a parameter block through opt at learning_rate, or plain
+ * SGD when opt is NULL; both sweeps are threaded for large blocks.
+ */
+void float_optim_apply(FloatOptimizer *opt, double *params, const double *grads, size_t count,
+                       double learning_rate) {
+    if (opt != NULL) {
+        opt->learning_rate = learning_rate;
+        float_optim_step(opt, params, grads);
+        return;
+    }
+    long n = (long)count;
+    int parallel = (double)count >= float_tuning()->parallel_threshold;
+    #pragma omp parallel for simd schedule(static) if(parallel)
+    for (long i = 0; i < n; i++) {
+        params[i] -= learning_rate * grads[i];
+    }
+}
+
+/* f(p) = 0.5 sum a_i (p_i - c_i)^2 with curvatures a_i from 1 to 100; writes the gradient. */
+static double quadratic(const double *p, const double *a, const double *c, double *g, size_t n) {
+    double f = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double d = p[i] - c[i];
+        g[i] = a[i] * d;
+        f += 0.5 * a[i] * d * d;
+    }
+    return f;
+}
+
+void test_float_optimizers() {
+    printf("\n=== Testing Fused Optimizers ===\n");
+
+    size_t n = 1001;
+    FloatMatrix *buffers = create_float_matrix(6, n);
+    if (buffers == NULL) return;
+    float_fill_uniform(buffers, -1.0, 1.0, 17);
+    double *p = buffers->data[0], *g = buffers->data[1];
+    double *a = buffers->data[2], *c = buffers->data[3];
+    double *ref_p = buffers->data[4], *ref_state = buffers->data[5];
+    for (size_t i = 0; i < n; i++) {
+        a[i] = 1.0 + 99.0 * (double)i / (double)(n - 1);
+    }
+
+    // Three Adam steps against the textbook formulas, element by element
+    FloatOptimizer *adam = float_optim_adam(n, 0.01, 0.9, 0.999, 1e-8);
+    if (adam != NULL) {
+        double ref_m[3] = {0.0, 0.0, 0.0}, ref_v[3] = {0.0, 0.0, 0.0};
+        memcpy(ref_p, p, n * sizeof(double));
+        for (int t = 1; t <= 3; t++) {
+            float_optim_step(adam, p, g);
+            for (size_t i = 0; i < 3; i++) {
+                ref_m[i] = 0.9 * ref_m[i] + 0.1 * g[i];
+                ref_v[i] = 0.999 * ref_v[i] + 0.001 * g[i] * g[i];
+                double m_hat = ref_m[i] / (1.0 - pow(0.9, t));
+                double v_hat = ref_v[i] / (1.0 - pow(0.999, t));
+                ref_p[i] -= 0.01 * m_hat / (sqrt(v_hat) + 1e-8);
+            }
+        }
+        double error = 0.0;
+        for (size_t i = 0; i < 3; i++) {
+            if (fabs(p[i] - ref_p[i]) > error) error = fabs(p[i] - ref_p[i]);
+        }
+        printf("Adam vs reference after 3 steps: %.2e (expected: < 1e-15)\n", error);
+        dealloc_float_optimizer(adam);
+    }
+
+    // Each optimizer on the ill-conditioned quadratic from the same start
+    const char *names[3] = {"SGD+momentum", "RMSProp", "Adam"};
+    for (int o = 0; o < 3; o++) {
+        FloatOptimizer *opt = NULL;
+        if (o == 0) opt = float_optim_sgd(n, 0.005, FLOAT_OPTIM_MOMENTUM);
+        if (o == 1) opt = float_optim_rmsprop(n, 0.003, FLOAT_OPTIM_RMSPROP_DECAY, FLOAT_OPTIM_EPSILON);
+        if (o == 2) opt = float_optim_adam(n, 0.02, FLOAT_OPTIM_ADAM_BETA1, FLOAT_OPTIM_ADAM_BETA2,
+                                           FLOAT_OPTIM_EPSILON);
+        if (opt == NULL) continue;
+        for (size_t i = 0; i < n; i++) {
+            p[i] = 0.0;
+        }
+        double start = quadratic(p, a, c, ref_state, n);
+        double f = start;
+        for (int step = 0; step < 1000; step++) {
+            f = quadratic(p, a, c, g, n);
+            float_optim_step(opt, p, g);
+        }
+        f = quadratic(p, a, c, g, n);
+        printf("%-13s loss %.3e -> %.3e (expected: below 1e-3 of the start)\n", names[o], start, f);
+        dealloc_float_optimizer(opt);
+    }
+
+    dealloc_float_matrix(buffers);
+}
+
+#ifndef NO_OPTIM_MAIN
+int main() {
+    printf("Optimizer Test\n");
+    printf("==============\n");
+
+    test_float_optimizers();
+
+    printf("\n✓ All optimizer tests completed!\n");
+    return 0;
+}
+#endif
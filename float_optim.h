@@ -0,0 +1,57 @@
+#ifndef FLOAT_OPTIM_H
+#define FLOAT_OPTIM_H
+
+#include <stdint.h>
+#include "float_matrix.h"
+
+/* Usual defaults for the constructors' hyper-parameters. */
+#define FLOAT_OPTIM_MOMENTUM 0.9
+#define FLOAT_OPTIM_RMSPROP_DECAY 0.99
+#define FLOAT_OPTIM_ADAM_BETA1 0.9
+#define FLOAT_OPTIM_ADAM_BETA2 0.999
+#define FLOAT_OPTIM_EPSILON 1e-8
+
+typedef enum FloatOptimizerKind {
+    FLOAT_OPTIM_SGD,
+    FLOAT_OPTIM_RMSPROP,
+    FLOAT_OPTIM_ADAM
+} FloatOptimizerKind;
+
+/*
+ * Optimizer over one contiguous vector of count parameters. float_optim_step
+ * reads the gradient and the state and writes the parameters in a single
+ * fused pass:
+ *   SGD      v = momentum v + g;              p -= lr v   (no state when momentum is 0)
+ *   RMSProp  s = decay s + (1 - decay) g^2;   p -= lr g / (sqrt(s) + eps)
+ *   Adam     m = b1 m + (1 - b1) g;  v = b2 v + (1 - b2) g^2;
+ *            p -= lr m^ / (sqrt(v^) + eps), with the bias-corrected m^, v^
+ * first and second are 1 x count state vectors (NULL when unused) and step
+ * counts the updates made so far.
+ */
+typedef struct FloatOptimizer {
+    FloatOptimizerKind kind;
+    size_t count;
+    double learning_rate;
+    double beta1;
+    double beta2;
+    double epsilon;
+    uint64_t step;
+    FloatMatrix *first;
+    FloatMatrix *second;
+} FloatOptimizer;
+
+FloatOptimizer* float_optim_sgd(size_t count, double learning_rate, double momentum);
+FloatOptimizer* float_optim_rmsprop(size_t count, double learning_rate, double decay, double epsilon);
+FloatOptimizer* float_optim_adam(size_t count, double learning_rate, double beta1, double beta2,
+                                 double epsilon);
+void dealloc_float_optimizer(FloatOptimizer *opt);
+void float_optim_reset(FloatOptimizer *opt);
+void float_optim_step(FloatOptimizer *opt, double *params, const double *grads);
+void float_optim_apply(FloatOptimizer *opt, double *params, const double *grads, size_t count,
+                       double learning_rate);
+size_t float_optim_padded_length(size_t n);
+int float_optim_fits(const FloatOptimizer *opt, size_t count);
+
+void test_float_optimizers(void);
+
+#endif
@@ -0,0 +1,516 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_optim.h"
+#include "float_rnn.h"
+#include "matrix_random.h"
+#include "activ_func/nn_func.h"
+
+/*
+ * inputs features per step, hidden units, chunks of up to max_steps steps
+ * of max_batch sequences. Weights are Xavier-initialised from seed, biases
+ * start at zero except the LSTM forget gate's, which starts at 1 so the
+ * cell remembers by default.
+ */
+FloatRNN* float_rnn_create(FloatCell cell, size_t inputs, size_t hidden, size_t max_steps,
+                           size_t max_batch, uint64_t seed) {
+    if (inputs == 0 || hidden == 0 || max_steps == 0 || max_batch == 0) {
+        printf("A recurrent layer needs positive inputs, hidden units, steps and batch\n");
+        return NULL;
+    }
+    FloatRNN *rnn = (FloatRNN *)calloc(1, sizeof(FloatRNN));
+    if (rnn == NULL) {
+        perror("Failed to allocate memory for FloatRNN");
+        return NULL;
+    }
+    size_t width = (cell == FLOAT_CELL_LSTM ? 4 : 3) * hidden;
+    size_t rows = max_steps * max_batch;
+    rnn->cell = cell;
+    rnn->inputs = inputs;
+    rnn->hidden = hidden;
+    rnn->gate_width = width;
+    rnn->max_steps = max_steps;
+    rnn->max_batch = max_batch;
+    rnn->parameter_count = float_optim_padded_length(inputs * width) +
+                           float_optim_padded_length(hidden * width) + float_optim_padded_length(width);
+
+    rnn->parameters = create_float_matrix(1, rnn->parameter_count);
+    rnn->gradients = create_float_matrix(1, rnn->parameter_count);
+    if (rnn->parameters == NULL || rnn->gradients == NULL) {
+        dealloc_float_rnn(rnn);
+        return NULL;
+    }
+    init_float_zero(rnn->parameters);
+    init_float_zero(rnn->gradients);
+    double *params = rnn->parameters->data[0];
+    double *grads = rnn->gradients->data[0];
+    size_t hidden_offset = float_optim_padded_length(inputs * width);
+    size_t bias_offset = hidden_offset + float_optim_padded_length(hidden * width);
+    rnn->input_weights = float_matrix_view(params, inputs, width);
+    rnn->hidden_weights = float_matrix_view(params + hidden_offset, hidden, width);
+    rnn->bias = float_matrix_view(params + bias_offset, 1, width);
+    rnn->input_weight_grad = float_matrix_view(grads, inputs, width);
+    rnn->hidden_weight_grad = float_matrix_view(grads + hidden_offset, hidden, width);
+    rnn->bias_grad = float_matrix_view(grads + bias_offset, 1, width);
+
+    rnn->gates = create_float_matrix(rows, width);
+    rnn->states = create_float_matrix(rows + max_batch, hidden);
+    rnn->d_gates = create_float_matrix(rows, width);
+    rnn->d_state = create_float_matrix(max_batch, hidden);
+    int cell_buffers_ok;
+    if (cell == FLOAT_CELL_LSTM) {
+        rnn->cells = create_float_matrix(rows + max_batch, hidden);
+        rnn->cell_tanh = create_float_matrix(rows, hidden);
+        rnn->d_cell = create_float_matrix(max_batch, hidden);
+        cell_buffers_ok = rnn->cells != NULL && rnn->cell_tanh != NULL && rnn->d_cell != NULL;
+    } else {
+        rnn->hidden_proj = create_float_matrix(rows, width);
+        rnn->d_hidden_proj = create_float_matrix(rows, width);
+        cell_buffers_ok = rnn->hidden_proj != NULL && rnn->d_hidden_proj != NULL;
+    }
+    if (rnn->input_weights == NULL || rnn->hidden_weights == NULL || rnn->bias == NULL ||
+        rnn->input_weight_grad == NULL || rnn->hidden_weight_grad == NULL || rnn->bias_grad == NULL ||
+        rnn->gates == NULL || rnn->states == NULL || rnn->d_gates == NULL || rnn->d_state == NULL ||
+        !cell_buffers_ok) {
+        dealloc_float_rnn(rnn);
+        return NULL;
+    }
+
+    float_init_xavier(rnn->input_weights, seed + 0x9E3779B97F4A7C15ULL);
+    float_init_xavier(rnn->hidden_weights, seed + 2 * 0x9E3779B97F4A7C15ULL);
+    if (cell == FLOAT_CELL_LSTM) {
+        for (size_t j = hidden; j < 2 * hidden; j++) {
+            rnn->bias->data[0][j] = 1.0;
+        }
+    }
+    float_rnn_reset_state(rnn);
+    return rnn;
+}
+
+void dealloc_float_rnn(FloatRNN *rnn) {
+    if (rnn == NULL) return;
+    dealloc_float_matrix(rnn->input_weights);
+    dealloc_float_matrix(rnn->hidden_weights);
+    dealloc_float_matrix(rnn->bias);
+    dealloc_float_matrix(rnn->input_weight_grad);
+    dealloc_float_matrix(rnn->hidden_weight_grad);
+    dealloc_float_matrix(rnn->bias_grad);
+    dealloc_float_matrix(rnn->parameters);
+    dealloc_float_matrix(rnn->gradients);
+    dealloc_float_matrix(rnn->gates);
+    dealloc_float_matrix(rnn->states);
+    dealloc_float_matrix(rnn->cells);
+    dealloc_float_matrix(rnn->cell_tanh);
+    dealloc_float_matrix(rnn->hidden_proj);
+    dealloc_float_matrix(rnn->d_gates);
+    dealloc_float_matrix(rnn->d_hidden_proj);
+    dealloc_float_matrix(rnn->d_state);
+    dealloc_float_matrix(rnn->d_cell);
+    free(rnn);
+}
+
+/* The next forward call starts a new sequence from a zero state. */
+void float_rnn_reset_state(FloatRNN *rnn) {
+    rnn->steps = 0;
+    rnn->batch = 0;
+}
+
+/* Same contract as float_mlp_set_optimizer. */
+int float_rnn_set_optimizer(FloatRNN *rnn, FloatOptimizer *optimizer) {
+    if (float_optim_fits(optimizer, rnn->parameter_count) != 0) {
+        return -1;
+    }
+    rnn->optimizer = optimizer;
+    return 0;
+}
+
+/* One LSTM step on the batch rows: gates already hold the pre-activations. */
+static void lstm_step(FloatRNN *rnn, double *gates, const double *c_prev, double *c, double *tc,
+                      double *h, size_t batch) {
+    size_t H = rnn->hidden, G = rnn->gate_width;
+    for (size_t b = 0; b < batch; b++) {
+        double *row = gates + b * G;
+        sigmoid_array_inplace(row, 3 * H);
+        tanh_array_inplace(row + 3 * H, H);
+        const double *i = row, *f = row + H, *g = row + 3 * H;
+        const double *cp = c_prev + b * H;
+        double *c_row = c + b * H;
+        #pragma omp simd
+        for (size_t j = 0; j < H; j++) {
+            c_row[j] = f[j] * cp[j] + i[j] * g[j];
+        }
+    }
+    tanh_array(c, tc, batch * H);
+    for (size_t b = 0; b < batch; b++) {
+        const double *o = gates + b * G + 2 * H;
+        const double *tc_row = tc + b * H;
+        double *h_row = h + b * H;
+        #pragma omp simd
+        for (size_t j = 0; j < H; j++) {
+            h_row[j] = o[j] * tc_row[j];
+        }
+    }
+}
+
+/* One GRU step: gates hold x W + b, hidden_proj holds h_{t-1} U. */
+static void gru_step(FloatRNN *rnn, double *gates, const double *hidden_proj, const double *h_prev,
+                     double *h, size_t batch) {
+    size_t H = rnn->hidden, G = rnn->gate_width;
+    for (size_t b = 0; b < batch; b++) {
+        double *row = gates + b * G;
+        const double *hp = hidden_proj + b * G;
+        #pragma omp simd
+        for (size_t j = 0; j < 2 * H; j++) {
+            row[j] += hp[j];
+        }
+        sigmoid_array_inplace(row, 2 * H);
+        const double *r = row;
+        double *n = row + 2 * H;
+        #pragma omp simd
+        for (size_t j = 0; j < H; j++) {
+            n[j] += r[j] * hp[2 * H + j];
+        }
+        tanh_array_inplace(n, H);
+        const double *z = row + H, *hp_row = h_prev + b * H;
+        double *h_row = h + b * H;
+        #pragma omp simd
+        for (size_t j = 0; j < H; j++) {
+            h_row[j] = (1.0 - z[j]) * n[j] + z[j] * hp_row[j];
+        }
+    }
+}
+
+/*
+ * Runs one chunk of steps x batch time-major inputs (steps*batch x inputs)
+ * and returns the hidden states h_0..h_{steps-1}, steps*batch x hidden, or
+ * NULL when the chunk does not fit the buffers.
+ */
+const double* float_rnn_forward(FloatRNN *rnn, const double *inputs, size_t steps, size_t batch) {
+    if (steps == 0 || steps > rnn->max_steps || batch == 0 || batch > rnn->max_batch) {
+        printf("Chunk of %zu steps x %zu sequences is outside %zu x %zu\n",
+               steps, batch, rnn->max_steps, rnn->max_batch);
+        return NULL;
+    }
+    size_t H = rnn->hidden, G = rnn->gate_width, rows = steps * batch;
+    double *h = rnn->states->data[0];
+    double *c = (rnn->cells != NULL) ? rnn->cells->data[0] : NULL;
+
+    // Block 0 takes over the state the previous chunk ended in
+    if (rnn->steps > 0 && rnn->batch == batch) {
+        memcpy(h, h + rnn->steps * batch * H, batch * H * sizeof(double));
+        if (c != NULL) memcpy(c, c + rnn->steps * batch * H, batch * H * sizeof(double));
+    } else {
+        memset(h, 0, batch * H * sizeof(double));
+        if (c != NULL) memset(c, 0, batch * H * sizeof(double));
+    }
+    rnn->steps = steps;
+    rnn->batch = batch;
+
+    // X W + b for the whole chunk in one GEMM
+    double *gates = rnn->gates->data[0];
+    const double *bias = rnn->bias->data[0];
+    for (size_t r = 0; r < rows; r++) {
+        memcpy(gates + r * G, bias, G * sizeof(double));
+    }
+    float_gemm_kernel(rows, G, rnn->inputs, 1.0, inputs, rnn->inputs,
+                      rnn->input_weights->data[0], G, gates, G);
+
+    const double *U = rnn->hidden_weights->data[0];
+    for (size_t t = 0; t < steps; t++) {
+        double *gates_t = gates + t * batch * G;
+        const double *h_prev = h + t * batch * H;
+        double *h_t = h + (t + 1) * batch * H;
+        if (rnn->cell == FLOAT_CELL_LSTM) {
+            float_gemm_kernel(batch, G, H, 1.0, h_prev, H, U, G, gates_t, G);
+            lstm_step(rnn, gates_t, c + t * batch * H, c + (t + 1) * batch * H,
+                      rnn->cell_tanh->data[0] + t * batch * H, h_t, batch);
+        } else {
+            double *proj_t = rnn->hidden_proj->data[0] + t * batch * G;
+            memset(proj_t, 0, batch * G * sizeof(double));
+            float_gemm_kernel(batch, G, H, 1.0, h_prev, H, U, G, proj_t, G);
+            gru_step(rnn, gates_t, proj_t, h_prev, h_t, batch);
+        }
+    }
+    return h + batch * H;
+}
+
+/* dLoss/d pre-activations of one LSTM step; d_state/d_cell carry dh and dc between steps. */
+static void lstm_step_backward(FloatRNN *rnn, size_t t) {
+    size_t H = rnn->hidden, G = rnn->gate_width, batch = rnn->batch;
+    for (size_t b = 0; b < batch; b++) {
+        size_t row = t * batch + b;
+        const double *i = rnn->gates->data[0] + row * G;
+        const double *f = i + H, *o = i + 2 * H, *g = i + 3 * H;
+        const double *tc = rnn->cell_tanh->data[0] + row * H;
+        const double *c_prev = rnn->cells->data[0] + row * H;
+        double *dh = rnn->d_state->data[0] + b * H;
+        double *dc = rnn->d_cell->data[0] + b * H;
+        double *di = rnn->d_gates->data[0] + row * G;
+        double *df = di + H, *d_o = di + 2 * H, *dg = di + 3 * H;
+        #pragma omp simd
+        for (size_t j = 0; j < H; j++) {
+            double dct = dc[j] + dh[j] * o[j] * (1.0 - tc[j] * tc[j]);
+            d_o[j] = dh[j] * tc[j] * o[j] * (1.0 - o[j]);
+            di[j] = dct * g[j] * i[j] * (1.0 - i[j]);
+            df[j] = dct * c_prev[j] * f[j] * (1.0 - f[j]);
+            dg[j] = dct * i[j] * (1.0 - g[j] * g[j]);
+            dc[j] = dct * f[j];
+        }
+    }
+    memset(rnn->d_state->data[0], 0, batch * H * sizeof(double));
+}
+
+/* The GRU step: d_state is left holding the direct z * dh path into h_{t-1}. */
+static void gru_step_backward(FloatRNN *rnn, size_t t) {
+    size_t H = rnn->hidden, G = rnn->gate_width, batch = rnn->batch;
+    for (size_t b = 0; b < batch; b++) {
+        size_t row = t * batch + b;
+        const double *r = rnn->gates->data[0] + row * G;
+        const double *z = r + H, *n = r + 2 * H;
+        const double *hp_n = rnn->hidden_proj->data[0] + row * G + 2 * H;
+        const double *h_prev = rnn->states->data[0] + row * H;
+        double *dh = rnn->d_state->data[0] + b * H;
+        double *dr = rnn->d_gates->data[0] + row * G;
+        double *dz = dr + H, *dn = dr + 2 * H;
+        double *dhr = rnn->d_hidden_proj->data[0] + row * G;
+        double *dhz = dhr + H, *dhn = dhr + 2 * H;
+        #pragma omp simd
+        for (size_t j = 0; j < H; j++) {
+            double dn_pre = dh[j] * (1.0 - z[j]) * (1.0 - n[j] * n[j]);
+            double dz_pre = dh[j] * (h_prev[j] - n[j]) * z[j] * (1.0 - z[j]);
+            double dr_pre = dn_pre * hp_n[j] * r[j] * (1.0 - r[j]);
+            dr[j] = dr_pre;
+            dz[j] = dz_pre;
+            dn[j] = dn_pre;
+            dhr[j] = dr_pre;
+            dhz[j] = dz_pre;
+            dhn[j] = dn_pre * r[j];
+            dh[j] *= z[j];
+        }
+    }
+}
+
+/*
+ * Backpropagates through the last forward chunk. inputs must be the ones
+ * that chunk ran on and d_outputs is dLoss/dh_t, steps*batch x hidden.
+ * Replaces the gradients and, when d_inputs is not NULL, writes
+ * dLoss/dx_t there (steps*batch x inputs). Nothing flows into the state
+ * the chunk started from. Returns -1 when no chunk has been run.
+ */
+int float_rnn_backward(FloatRNN *rnn, const double *inputs, const double *d_outputs, double *d_inputs) {
+    size_t steps = rnn->steps, batch = rnn->batch;
+    if (steps == 0) {
+        printf("Backward pass without a forward chunk\n");
+        return -1;
+    }
+    size_t H = rnn->hidden, G = rnn->gate_width, rows = steps * batch;
+    const double *U = rnn->hidden_weights->data[0];
+    double *d_state = rnn->d_state->data[0];
+    double *d_proj = (rnn->cell == FLOAT_CELL_LSTM) ? rnn->d_gates->data[0] : rnn->d_hidden_proj->data[0];
+    memset(d_state, 0, batch * H * sizeof(double));
+    if (rnn->d_cell != NULL) memset(rnn->d_cell->data[0], 0, batch * H * sizeof(double));
+
+    for (size_t t = steps; t-- > 0;) {
+        const double *d_out = d_outputs + t * batch * H;
+        #pragma omp simd
+        for (size_t j = 0; j < batch * H; j++) {
+            d_state[j] += d_out[j];
+        }
+        if (rnn->cell == FLOAT_CELL_LSTM) {
+            lstm_step_backward(rnn, t);
+        } else {
+            gru_step_backward(rnn, t);
+        }
+        // dh_{t-1} += dLoss/d(h U) U^T
+        float_gemm_kernel_nt(batch, H, G, 1.0, d_proj + t * batch * G, G, U, G, d_state, H);
+    }
+
+    // Weight gradients over the whole chunk, one GEMM each
+    memset(rnn->gradients->data[0], 0, rnn->parameter_count * sizeof(double));
+    const double *d_gates = rnn->d_gates->data[0];
+    float_gemm_kernel_tn(rnn->inputs, G, rows, 1.0, inputs, rnn->inputs, d_gates, G,
+                         rnn->input_weight_grad->data[0], G);
+    float_gemm_kernel_tn(H, G, rows, 1.0, rnn->states->data[0], H, d_proj, G,
+                         rnn->hidden_weight_grad->data[0], G);
+    double *bias_grad = rnn->bias_grad->data[0];
+    for (size_t r = 0; r < rows; r++) {
+        const double *d_row = d_gates + r * G;
+        #pragma omp simd
+        for (size_t j = 0; j < G; j++) {
+            bias_grad[j] += d_row[j];
+        }
+    }
+    if (d_inputs != NULL) {
+        memset(d_inputs, 0, rows * rnn->inputs * sizeof(double));
+        float_gemm_kernel_nt(rows, rnn->inputs, G, 1.0, d_gates, G,
+                             rnn->input_weights->data[0], G, d_inputs, rnn->inputs);
+    }
+    return 0;
+}
+
+/* Applies the gradients through the layer's optimizer, or plain SGD without one. */
+void float_rnn_update(FloatRNN *rnn, double learning_rate) {
+    float_optim_apply(rnn->optimizer, rnn->parameters->data[0], rnn->gradients->data[0],
+                      rnn->parameter_count, learning_rate);
+}
+
+/* 0.5 * sum((h - target)^2) over a fresh chunk. */
+static double chunk_loss(FloatRNN *rnn, const double *inputs, const double *targets,
+                         size_t steps, size_t batch) {
+    float_rnn_reset_state(rnn);
+    const double *h = float_rnn_forward(rnn, inputs, steps, batch);
+    double loss = 0.0;
+    for (size_t j = 0; j < steps * batch * rnn->hidden; j++) {
+        loss += 0.5 * (h[j] - targets[j]) * (h[j] - targets[j]);
+    }
+    return loss;
+}
+
+void test_float_rnn_gradients() {
+    printf("\n=== Testing LSTM/GRU Gradients ===\n");
+
+    size_t steps = 5, batch = 2, inputs = 3, hidden = 4;
+    FloatMatrix *data = create_float_matrix(3 * steps * batch, hidden);
+    if (data == NULL) return;
+    float_fill_uniform(data, -1.0, 1.0, 31);
+    double *x = data->data[0];
+    double *targets = data->data[steps * batch];
+    double *d_out = data->data[2 * steps * batch];
+    double d_inputs[5 * 2 * 3];
+
+    const char *names[2] = {"LSTM", "GRU"};
+    for (int kind = 0; kind < 2; kind++) {
+        FloatRNN *rnn = float_rnn_create(kind == 0 ? FLOAT_CELL_LSTM : FLOAT_CELL_GRU,
+                                         inputs, hidden, steps, batch, 3);
+        if (rnn == NULL) continue;
+
+        float_rnn_reset_state(rnn);
+        const double *h = float_rnn_forward(rnn, x, steps, batch);
+        for (size_t j = 0; j < steps * batch * hidden; j++) {
+            d_out[j] = h[j] - targets[j];
+        }
+        float_rnn_backward(rnn, x, d_out, d_inputs);
+
+        // Central differences on every parameter (padding included) and input
+        double eps = 1e-6, worst = 0.0;
+        double *params = rnn->parameters->data[0];
+        for (size_t i = 0; i < rnn->parameter_count + steps * batch * inputs; i++) {
+            double *value = (i < rnn->parameter_count) ? &params[i] : &x[i - rnn->parameter_count];
+            double analytic = (i < rnn->parameter_count) ? rnn->gradients->data[0][i]
+                                                         : d_inputs[i - rnn->parameter_count];
+            double saved = *value;
+            *value = saved + eps;
+            double up = chunk_loss(rnn, x, targets, steps, batch);
+            *value = saved - eps;
+            double down = chunk_loss(rnn, x, targets, steps, batch);
+            *value = saved;
+            double error = fabs((up - down) / (2.0 * eps) - analytic);
+            if (error > worst) worst = error;
+        }
+        printf("%-4s gradient error vs finite differences: %.2e (expected: < 1e-8)\n",
+               names[kind], worst);
+
+        // Two chunks of 2 and 3 steps must continue the state of one 5-step chunk
+        double whole[5 * 2 * 4];
+        float_rnn_reset_state(rnn);
+        memcpy(whole, float_rnn_forward(rnn, x, steps, batch), sizeof(whole));
+        float_rnn_reset_state(rnn);
+        float_rnn_forward(rnn, x, 2, batch);
+        h = float_rnn_forward(rnn, x + 2 * batch * inputs, 3, batch);
+        double carry_error = 0.0;
+        for (size_t j = 0; j < 3 * batch * hidden; j++) {
+            double error = fabs(h[j] - whole[2 * batch * hidden + j]);
+            if (error > carry_error) carry_error = error;
+        }
+        printf("%-4s chunked vs whole-sequence states: %.2e (expected: 0)\n", names[kind], carry_error);
+        dealloc_float_rnn(rnn);
+    }
+    dealloc_float_matrix(data);
+}
+
+void test_float_rnn_training() {
+    printf("\n=== Testing LSTM/GRU Training (echo of the input 2 steps back) ===\n");
+
+    // 16 sequences of 64 steps, trained in truncated chunks of 8 steps
+    size_t batch = 16, chunk = 8, length = 64, hidden = 8;
+    FloatMatrix *x = create_float_matrix(length * batch, 1);
+    FloatMatrix *h_grad = create_float_matrix(chunk * batch, hidden);
+    if (x == NULL || h_grad == NULL) {
+        dealloc_float_matrix(x);
+        dealloc_float_matrix(h_grad);
+        return;
+    }
+    init_float_zero(h_grad);
+    MatrixRng rng;
+    matrix_rng_seed(&rng, 13, 0);
+
+    const char *names[2] = {"LSTM", "GRU"};
+    for (int kind = 0; kind < 2; kind++) {
+        FloatRNN *rnn = float_rnn_create(kind == 0 ? FLOAT_CELL_LSTM : FLOAT_CELL_GRU,
+                                         1, hidden, chunk, batch, 5);
+        FloatOptimizer *adam = (rnn != NULL)
+            ? float_optim_adam(rnn->parameter_count, 0.01, FLOAT_OPTIM_ADAM_BETA1,
+                               FLOAT_OPTIM_ADAM_BETA2, FLOAT_OPTIM_EPSILON)
+            : NULL;
+        if (adam == NULL) {
+            dealloc_float_rnn(rnn);
+            continue;
+        }
+        float_rnn_set_optimizer(rnn, adam);
+
+        double first_loss = 0.0, loss = 0.0;
+        long allocs_before = 0;
+        for (int sequence = 0; sequence < 400; sequence++) {
+            if (sequence == 1) {
+                allocs_before = matrix_alloc_count();
+            }
+            for (size_t j = 0; j < length * batch; j++) {
+                x->data[j][0] = matrix_rng_uniform(&rng) - 0.5;
+            }
+            // Unit 0 of h_t is trained towards x_{t-2}; the first two steps have no target
+            loss = 0.0;
+            float_rnn_reset_state(rnn);
+            for (size_t start = 0; start < length; start += chunk) {
+                const double *inputs = x->data[start * batch];
+                const double *h = float_rnn_forward(rnn, inputs, chunk, batch);
+                for (size_t t = 0; t < chunk; t++) {
+                    for (size_t b = 0; b < batch; b++) {
+                        size_t step = start + t;
+                        double *d = h_grad->data[t * batch + b];
+                        d[0] = 0.0;
+                        if (step >= 2) {
+                            d[0] = h[(t * batch + b) * hidden] - x->data[(step - 2) * batch + b][0];
+                            loss += 0.5 * d[0] * d[0];
+                            d[0] /= (double)batch;
+                        }
+                    }
+                }
+                float_rnn_backward(rnn, inputs, h_grad->data[0], NULL);
+                float_rnn_update(rnn, 0.01);
+            }
+            loss /= (double)((length - 2) * batch);
+            if (sequence == 0) first_loss = loss;
+        }
+        printf("%-4s loss per step %.5f -> %.5f (expected: below 0.002)\n", names[kind], first_loss, loss);
+        matrix_expect_no_allocs(allocs_before, "399 training sequences");
+        dealloc_float_optimizer(adam);
+        dealloc_float_rnn(rnn);
+    }
+    dealloc_float_matrix(x);
+    dealloc_float_matrix(h_grad);
+}
+
+#ifndef NO_RNN_MAIN
+int main() {
+    printf("Recurrent Layer Test\n");
+    printf("====================\n");
+
+    test_float_rnn_gradients();
+    test_float_rnn_training();
+
+    printf("\n✓ All recurrent layer tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,75 @@
+#ifndef FLOAT_RNN_H
+#define FLOAT_RNN_H
+
+#include <stdint.h>
+#include "float_matrix.h"
+#include "float_optim.h"
+
+/*
+ * LSTM gates are laid out [input, forget, output, candidate] so the three
+ * sigmoid gates of a row are contiguous; GRU gates are [reset, update,
+ * candidate], with n = tanh(x Wn + bn + r * (h Un)).
+ */
+typedef enum FloatCell {
+    FLOAT_CELL_LSTM,
+    FLOAT_CELL_GRU
+} FloatCell;
+
+/*
+ * Recurrent layer over time-major sequences: step t of batch row b is row
+ * t * batch + b of a steps*batch x width block. All gate projections are
+ * concatenated, gate_width = 4 (LSTM) or 3 (GRU) x hidden wide, so
+ *   - X W + b for every timestep of a chunk is one GEMM before the recurrence,
+ *   - h_{t-1} U is one batch x gate_width GEMM per timestep,
+ *   - dW, dU and the input gradient are one GEMM each after it.
+ * Weights and biases share one parameter block, as in FloatMLP, and every
+ * per-timestep buffer is sized for max_steps x max_batch at creation.
+ *
+ * Truncated BPTT: each forward call is one chunk. It starts from the state
+ * the previous chunk ended in (zeros after float_rnn_reset_state or a
+ * change of batch size), and the backward pass stops at the chunk's first
+ * step.
+ */
+typedef struct FloatRNN {
+    FloatCell cell;
+    size_t inputs;
+    size_t hidden;
+    size_t gate_width;
+    size_t max_steps;
+    size_t max_batch;
+    size_t steps;
+    size_t batch;
+    size_t parameter_count;
+    FloatMatrix *parameters;
+    FloatMatrix *gradients;
+    FloatMatrix *input_weights;       // inputs x gate_width
+    FloatMatrix *hidden_weights;      // hidden x gate_width
+    FloatMatrix *bias;                // 1 x gate_width
+    FloatMatrix *input_weight_grad;
+    FloatMatrix *hidden_weight_grad;
+    FloatMatrix *bias_grad;
+    FloatMatrix *gates;               // activated gates, max_steps*max_batch x gate_width
+    FloatMatrix *states;              // h_{t-1} in block t, (max_steps+1)*max_batch x hidden
+    FloatMatrix *cells;               // LSTM c_{t-1} in block t, like states
+    FloatMatrix *cell_tanh;           // LSTM tanh(c_t), max_steps*max_batch x hidden
+    FloatMatrix *hidden_proj;         // GRU h_{t-1} U, max_steps*max_batch x gate_width
+    FloatMatrix *d_gates;             // dLoss/d(X W + b), max_steps*max_batch x gate_width
+    FloatMatrix *d_hidden_proj;       // GRU dLoss/d(h U); the LSTM uses d_gates
+    FloatMatrix *d_state;             // max_batch x hidden
+    FloatMatrix *d_cell;              // LSTM, max_batch x hidden
+    FloatOptimizer *optimizer;
+} FloatRNN;
+
+FloatRNN* float_rnn_create(FloatCell cell, size_t inputs, size_t hidden, size_t max_steps,
+                           size_t max_batch, uint64_t seed);
+void dealloc_float_rnn(FloatRNN *rnn);
+void float_rnn_reset_state(FloatRNN *rnn);
+int float_rnn_set_optimizer(FloatRNN *rnn, FloatOptimizer *optimizer);
+const double* float_rnn_forward(FloatRNN *rnn, const double *inputs, size_t steps, size_t batch);
+int float_rnn_backward(FloatRNN *rnn, const double *inputs, const double *d_outputs, double *d_inputs);
+void float_rnn_update(FloatRNN *rnn, double learning_rate);
+
+void test_float_rnn_gradients(void);
+void test_float_rnn_training(void);
+
+#endif
@@ -0,0 +1,525 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "float_matrix.h"
+#include "float_ooc.h"
+#include "matrix_random.h"
+#include "float_svd.h"
+
+/*
+ * Householder QR of an m x n A (m >= n): A = Q R with Q m x n orthonormal
+ * and R n x n upper triangular. Q may be NULL when only R is wanted.
+ * Reflectors are applied a row at a time (t = v^T W, then W -= beta v t^T)
+ * so the row-major matrix is streamed rather than walked by column.
+ * Returns 0, or -1 on a shape or allocation failure.
+ */
+int float_qr(FloatMatrix *A, FloatMatrix **Q, FloatMatrix **R) {
+    size_t m = A->rows, n = A->cols;
+    if (m < n) {
+        printf("QR needs at least as many rows as columns (%zu x %zu)\n", m, n);
+        return -1;
+    }
+
+    FloatMatrix *W = create_float_matrix(m, n);
+    FloatMatrix *result_r = create_float_matrix(n, n);
+    FloatMatrix *result_q = (Q != NULL) ? create_float_matrix(m, n) : NULL;
+    double *beta = (double *)calloc(n, sizeof(double));
+    double *diag = (double *)calloc(n, sizeof(double));
+    double *t = (double *)malloc(n * sizeof(double));
+    if (W == NULL || result_r == NULL || (Q != NULL && result_q == NULL) ||
+        beta == NULL || diag == NULL || t == NULL) {
+        dealloc_float_matrix(W);
+        dealloc_float_matrix(result_r);
+        dealloc_float_matrix(result_q);
+        free(beta); free(diag); free(t);
+        return -1;
+    }
+    memcpy(W->data[0], A->data[0], m * n * sizeof(double));
+
+    for (size_t j = 0; j < n; j++) {
+        double norm_sq = 0.0;
+        for (size_t i = j; i < m; i++) {
+            norm_sq += W->data[i][j] * W->data[i][j];
+        }
+        if (norm_sq == 0.0) {
+            continue;
+        }
+        double x0 = W->data[j][j];
+        double alpha = (x0 > 0.0) ? -sqrt(norm_sq) : sqrt(norm_sq);
+        double vv = norm_sq - x0 * x0 + (x0 - alpha) * (x0 - alpha);
+        W->data[j][j] = x0 - alpha;
+        beta[j] = 2.0 / vv;
+        diag[j] = alpha;
+
+        size_t rest = n - j - 1;
+        memset(t, 0, rest * sizeof(double));
+        for (size_t i = j; i < m; i++) {
+            double vi = W->data[i][j];
+            const double *row = W->data[i] + j + 1;
+            #pragma omp simd
+            for (size_t c = 0; c < rest; c++) {
+                t[c] += vi * row[c];
+            }
+        }
+        for (size_t i = j; i < m; i++) {
+            double scaled = beta[j] * W->data[i][j];
+            double *row = W->data[i] + j + 1;
+            #pragma omp simd
+            for (size_t c = 0; c < rest; c++) {
+                row[c] -= scaled * t[c];
+            }
+        }
+    }
+
+    init_float_zero(result_r);
+    for (size_t i = 0; i < n; i++) {
+        result_r->data[i][i] = diag[i];
+        for (size_t c = i + 1; c < n; c++) {
+            result_r->data[i][c] = W->data[i][c];
+        }
+    }
+
+    if (result_q != NULL) {
+        // Q = H_0 ... H_{n-1} [I; 0], accumulated from the last reflector back
+        init_float_zero(result_q);
+        for (size_t i = 0; i < n; i++) {
+            result_q->data[i][i] = 1.0;
+        }
+        for (size_t j = n; j-- > 0;) {
+            if (beta[j] == 0.0) continue;
+            size_t width = n - j;
+            memset(t, 0, width * sizeof(double));
+            for (size_t i = j; i < m; i++) {
+                double vi = W->data[i][j];
+                const double *row = result_q->data[i] + j;
+                #pragma omp simd
+                for (size_t c = 0; c < width; c++) {
+                    t[c] += vi * row[c];
+                }
+            }
+            for (size_t i = j; i < m; i++) {
+                double scaled = beta[j] * W->data[i][j];
+                double *row = result_q->data[i] + j;
+                #pragma omp simd
+                for (size_t c = 0; c < width; c++) {
+                    row[c] -= scaled * t[c];
+                }
+            }
+        }
+        *Q = result_q;
+    }
+
+    if (R != NULL) {
+        *R = result_r;
+    } else {
+        dealloc_float_matrix(result_r);
+    }
+    dealloc_float_matrix(W);
+    free(beta); free(diag); free(t);
+    return 0;
+}
+
+static int read_matrix_rows(void *context, size_t first, size_t count, double *out) {
+    FloatMatrix *A = (FloatMatrix *)context;
+    memcpy(out, A->data[first], count * A->cols * sizeof(double));
+    return 0;
+}
+
+static int read_file_rows(void *context, size_t first, size_t count, double *out) {
+    FloatMatrixFile *f = (FloatMatrixFile *)context;
+    memcpy(out, f->data + first * f->cols, count * f->cols * sizeof(double));
+    return 0;
+}
+
+FloatRowSource float_row_source_matrix(FloatMatrix *A) {
+    FloatRowSource source = { A->rows, A->cols, read_matrix_rows, A };
+    return source;
+}
+
+/* Rows of a memory-mapped matrix file; the OS pages blocks in as they are read. */
+FloatRowSource float_row_source_file(FloatMatrixFile *f) {
+    FloatRowSource source = { f->rows, f->cols, read_file_rows, f };
+    return source;
+}
+
+/*
+ * One-sided Jacobi SVD of the square l x l matrix R: rotates pairs of
+ * columns (held as rows of Rt = R^T) until all are orthogonal. Their
+ * norms are the singular values; the accumulated rotations (rows of Wt)
+ * are the right singular vectors. Results are sorted descending.
+ */
+static int jacobi_svd(FloatMatrix *R, double *sigma, FloatMatrix *W) {
+    size_t l = R->rows;
+    FloatMatrix *Rt = float_transpose(R);
+    FloatMatrix *Wt = create_float_matrix(l, l);
+    size_t *order = (size_t *)malloc(l * sizeof(size_t));
+    double *norms = (double *)malloc(l * sizeof(double));
+    if (Rt == NULL || Wt == NULL || order == NULL || norms == NULL) {
+        dealloc_float_matrix(Rt);
+        dealloc_float_matrix(Wt);
+        free(order);
+        free(norms);
+        return -1;
+    }
+    init_float_zero(Wt);
+    for (size_t i = 0; i < l; i++) Wt->data[i][i] = 1.0;
+
+    for (int sweep = 0; sweep < FLOAT_SVD_JACOBI_SWEEPS; sweep++) {
+        int rotated = 0;
+        for (size_t p = 0; p + 1 < l; p++) {
+            for (size_t q = p + 1; q < l; q++) {
+                double *rp = Rt->data[p], *rq = Rt->data[q];
+                double alpha = 0.0, beta = 0.0, gamma = 0.0;
+                for (size_t i = 0; i < l; i++) {
+                    alpha += rp[i] * rp[i];
+                    beta += rq[i] * rq[i];
+                    gamma += rp[i] * rq[i];
+                }
+                if (fabs(gamma) <= 1e-15 * sqrt(alpha * beta)) continue;
+                rotated = 1;
+
+                double zeta = (beta - alpha) / (2.0 * gamma);
+                double t = copysign(1.0, zeta) / (fabs(zeta) + sqrt(1.0 + zeta * zeta));
+                double c = 1.0 / sqrt(1.0 + t * t), s = c * t;
+                double *wp = Wt->data[p], *wq = Wt->data[q];
+                for (size_t i = 0; i < l; i++) {
+                    double x = rp[i], y = rq[i];
+                    rp[i] = c * x - s * y;
+                    rq[i] = s * x + c * y;
+                    x = wp[i];
+                    y = wq[i];
+                    wp[i] = c * x - s * y;
+                    wq[i] = s * x + c * y;
+                }
+            }
+        }
+        if (!rotated) break;
+    }
+
+    for (size_t j = 0; j < l; j++) {
+        double sum = 0.0;
+        for (size_t i = 0; i < l; i++) sum += Rt->data[j][i] * Rt->data[j][i];
+        norms[j] = sqrt(sum);
+        order[j] = j;
+    }
+    // Insertion sort: l is at most a few hundred
+    for (size_t j = 1; j < l; j++) {
+        size_t key = order[j], i = j;
+        while (i > 0 && norms[order[i - 1]] < norms[key]) {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = key;
+    }
+    for (size_t j = 0; j < l; j++) {
+        sigma[j] = norms[order[j]];
+        for (size_t i = 0; i < l; i++) {
+            W->data[i][j] = Wt->data[order[j]][i];
+        }
+    }
+
+    free(order);
+    free(norms);
+    dealloc_float_matrix(Rt);
+    dealloc_float_matrix(Wt);
+    return 0;
+}
+
+/* block (rows x n, leading dimension n) into blockT (n x rows, leading dimension ldt). */
+static void transpose_rows(const double *block, size_t rows, size_t n, double *blockT, size_t ldt) {
+    long tiles = (long)((rows + 31) / 32);
+    #pragma omp parallel for schedule(static) if((double)rows * (double)n >= float_tuning()->parallel_threshold)
+    for (long tile = 0; tile < tiles; tile++) {
+        size_t r0 = (size_t)tile * 32, r1 = (r0 + 32 < rows) ? r0 + 32 : rows;
+        for (size_t c0 = 0; c0 < n; c0 += 32) {
+            size_t c1 = (c0 + 32 < n) ? c0 + 32 : n;
+            for (size_t r = r0; r < r1; r++) {
+                for (size_t c = c0; c < c1; c++) {
+                    blockT[c * ldt + r] = block[r * n + c];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Randomized truncated SVD (Halko, Martinsson and Tropp) of a tall m x n
+ * matrix read in FLOAT_SVD_ROW_BLOCK row blocks, so only one block, the
+ * n x l sketch and l x l factors (l = k + oversample) are ever resident.
+ *
+ * The range finder works in the n-dimensional row space: each pass
+ * accumulates Z = A^T (A Q) block by block with the blocked GEMM and
+ * re-orthonormalises Z by QR; 1 + power_iterations passes sharpen the
+ * subspace. A final pass builds R of A Q by a streaming (TSQR) QR of the
+ * stacked blocks, a one-sided Jacobi SVD of R gives the singular values
+ * and V = Q W, and with want_u one more pass forms U = A V diag(1/sigma).
+ */
+FloatSVD* float_randomized_svd(FloatRowSource *source, size_t k, size_t oversample,
+                               size_t power_iterations, int want_u, uint64_t seed) {
+    size_t m = source->rows, n = source->cols;
+    size_t l = k + oversample;
+    if (l > n) l = n;
+    if (k == 0 || k > l || l > m) {
+        printf("Cannot take a rank-%zu SVD of a %zu x %zu matrix\n", k, m, n);
+        return NULL;
+    }
+    size_t block = (m < FLOAT_SVD_ROW_BLOCK) ? m : FLOAT_SVD_ROW_BLOCK;
+
+    FloatSVD *svd = (FloatSVD *)calloc(1, sizeof(FloatSVD));
+    FloatMatrix *Ab = create_float_matrix(block, n);
+    FloatMatrix *AbT = create_float_matrix(n, block);
+    FloatMatrix *Yb = create_float_matrix(block, l);
+    FloatMatrix *Z = create_float_matrix(n, l);
+    FloatMatrix *Qn = create_float_matrix(n, l);
+    FloatMatrix *stacked = create_float_matrix(l + block, l);
+    FloatMatrix *W = create_float_matrix(l, l);
+    double *sigma = (double *)malloc(l * sizeof(double));
+    int failed = svd == NULL || Ab == NULL || AbT == NULL || Yb == NULL || Z == NULL ||
+                 Qn == NULL || stacked == NULL || W == NULL || sigma == NULL;
+
+    if (!failed) {
+        float_fill_normal(Qn, 0.0, 1.0, seed);
+    }
+
+    for (size_t pass = 0; !failed && pass <= power_iterations; pass++) {
+        init_float_zero(Z);
+        for (size_t first = 0; !failed && first < m; first += block) {
+            size_t rows = (m - first < block) ? m - first : block;
+            if (source->read(source->context, first, rows, Ab->data[0]) != 0) {
+                failed = 1;
+                break;
+            }
+            memset(Yb->data[0], 0, rows * l * sizeof(double));
+            float_gemm_kernel(rows, l, n, 1.0, Ab->data[0], n, Qn->data[0], l, Yb->data[0], l);
+            transpose_rows(Ab->data[0], rows, n, AbT->data[0], block);
+            float_gemm_kernel(n, l, rows, 1.0, AbT->data[0], block, Yb->data[0], l, Z->data[0], l);
+        }
+        FloatMatrix *orth = NULL;
+        if (failed || float_qr(Z, &orth, NULL) != 0) {
+            failed = 1;
+            break;
+        }
+        memcpy(Qn->data[0], orth->data[0], n * l * sizeof(double));
+        dealloc_float_matrix(orth);
+    }
+
+    // TSQR of A Qn: R <- qr_r([R; A_b Qn]) over the blocks
+    FloatMatrix *R = failed ? NULL : create_float_matrix(l, l);
+    if (R != NULL) {
+        init_float_zero(R);
+    }
+    for (size_t first = 0; R != NULL && first < m; first += block) {
+        size_t rows = (m - first < block) ? m - first : block;
+        if (source->read(source->context, first, rows, Ab->data[0]) != 0) {
+            failed = 1;
+            break;
+        }
+        memcpy(stacked->data[0], R->data[0], l * l * sizeof(double));
+        memset(stacked->data[l], 0, rows * l * sizeof(double));
+        float_gemm_kernel(rows, l, n, 1.0, Ab->data[0], n, Qn->data[0], l, stacked->data[l], l);
+
+        FloatMatrix view = *stacked;
+        view.rows = l + rows;
+        FloatMatrix *next = NULL;
+        if (float_qr(&view, NULL, &next) != 0) {
+            failed = 1;
+            break;
+        }
+        dealloc_float_matrix(R);
+        R = next;
+    }
+    failed = failed || R == NULL;
+
+    failed = failed || jacobi_svd(R, sigma, W) != 0;
+    if (!failed) {
+        svd->k = k;
+        svd->values = (double *)malloc(k * sizeof(double));
+        svd->V = create_float_matrix(n, k);
+        failed = svd->values == NULL || svd->V == NULL;
+    }
+    if (!failed) {
+        memcpy(svd->values, sigma, k * sizeof(double));
+        // V = Qn W[:, :k]
+        init_float_zero(svd->V);
+        float_gemm_kernel(n, k, l, 1.0, Qn->data[0], l, W->data[0], l, svd->V->data[0], k);
+    }
+
+    if (!failed && want_u) {
+        svd->U = create_float_matrix(m, k);
+        failed = svd->U == NULL;
+        for (size_t first = 0; !failed && first < m; first += block) {
+            size_t rows = (m - first < block) ? m - first : block;
+            if (source->read(source->context, first, rows, Ab->data[0]) != 0) {
+                failed = 1;
+                break;
+            }
+            double *u = svd->U->data[first];
+            memset(u, 0, rows * k * sizeof(double));
+            float_gemm_kernel(rows, k, n, 1.0, Ab->data[0], n, svd->V->data[0], k, u, k);
+            for (size_t r = 0; r < rows; r++) {
+                for (size_t c = 0; c < k; c++) {
+                    u[r * k + c] = (svd->values[c] > 0.0) ? u[r * k + c] / svd->values[c] : 0.0;
+                }
+            }
+        }
+    }
+
+    dealloc_float_matrix(R);
+    dealloc_float_matrix(Ab);
+    dealloc_float_matrix(AbT);
+    dealloc_float_matrix(Yb);
+    dealloc_float_matrix(Z);
+    dealloc_float_matrix(Qn);
+    dealloc_float_matrix(stacked);
+    dealloc_float_matrix(W);
+    free(sigma);
+    if (failed) {
+        printf("Randomized SVD failed\n");
+        dealloc_float_svd(svd);
+        return NULL;
+    }
+    return svd;
+}
+
+void dealloc_float_svd(FloatSVD *svd) {
+    if (svd == NULL) return;
+    free(svd->values);
+    dealloc_float_matrix(svd->U);
+    dealloc_float_matrix(svd->V);
+    free(svd);
+}
+
+static FloatMatrix* random_orthonormal(size_t m, size_t n, uint64_t seed) {
+    FloatMatrix *G = create_float_matrix(m, n);
+    FloatMatrix *Q = NULL;
+    if (G != NULL) {
+        float_fill_normal(G, 0.0, 1.0, seed);
+        float_qr(G, &Q, NULL);
+    }
+    dealloc_float_matrix(G);
+    return Q;
+}
+
+void test_float_qr() {
+    printf("\n=== Testing Householder QR ===\n");
+
+    size_t m = 120, n = 40;
+    FloatMatrix *A = create_float_matrix(m, n);
+    if (A == NULL) return;
+    float_fill_uniform(A, -1.0, 1.0, 3);
+
+    FloatMatrix *Q = NULL, *R = NULL;
+    if (float_qr(A, &Q, &R) == 0) {
+        FloatMatrix *QR = float_multiply_matrix(Q, R);
+        double reconstruction = 0.0, orthogonality = 0.0, lower = 0.0;
+        for (size_t i = 0; QR != NULL && i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double error = fabs(QR->data[i][j] - A->data[i][j]);
+                if (error > reconstruction) reconstruction = error;
+            }
+        }
+        for (size_t a = 0; a < n; a++) {
+            for (size_t b = 0; b < n; b++) {
+                double dot = 0.0;
+                for (size_t i = 0; i < m; i++) dot += Q->data[i][a] * Q->data[i][b];
+                if (fabs(dot - (a == b ? 1.0 : 0.0)) > orthogonality) orthogonality = fabs(dot - (a == b ? 1.0 : 0.0));
+                if (b < a && fabs(R->data[a][b]) > lower) lower = fabs(R->data[a][b]);
+            }
+        }
+        printf("Max |QR - A|: %.3e (expected: < 1e-12)\n", reconstruction);
+        printf("Max |Q^T Q - I|: %.3e (expected: < 1e-12)\n", orthogonality);
+        printf("Largest entry below R's diagonal: %.1f (expected: 0.0)\n", lower);
+        dealloc_float_matrix(QR);
+    }
+
+    dealloc_float_matrix(Q);
+    dealloc_float_matrix(R);
+    dealloc_float_matrix(A);
+}
+
+void test_float_randomized_svd() {
+    printf("\n=== Testing Randomized SVD ===\n");
+
+    // A = U0 diag(s) V0^T with s_i = 10 * 0.7^i, over several row blocks
+    size_t m = 2 * FLOAT_SVD_ROW_BLOCK + 300, n = 80, k = 8;
+    FloatMatrix *U0 = random_orthonormal(m, n, 11);
+    FloatMatrix *V0 = random_orthonormal(n, n, 12);
+    FloatMatrix *A = create_float_matrix(m, n);
+    double s[80];
+    if (U0 == NULL || V0 == NULL || A == NULL) {
+        dealloc_float_matrix(U0);
+        dealloc_float_matrix(V0);
+        dealloc_float_matrix(A);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) s[i] = 10.0 * pow(0.7, (double)i);
+    for (size_t i = 0; i < m; i++) {
+        for (size_t c = 0; c < n; c++) U0->data[i][c] *= s[c];
+    }
+    FloatMatrix *V0t = float_transpose(V0);
+    init_float_zero(A);
+    float_gemm_kernel(m, n, n, 1.0, U0->data[0], n, V0t->data[0], n, A->data[0], n);
+
+    FloatRowSource source = float_row_source_matrix(A);
+    FloatSVD *svd = float_randomized_svd(&source, k, FLOAT_SVD_OVERSAMPLE, 2, 1, 99);
+    if (svd != NULL) {
+        double value_error = 0.0, residual = 0.0;
+        for (size_t c = 0; c < k; c++) {
+            if (fabs(svd->values[c] - s[c]) / s[0] > value_error) value_error = fabs(svd->values[c] - s[c]) / s[0];
+        }
+        // || A v_c - sigma_c u_c || over all rows
+        for (size_t c = 0; c < k; c++) {
+            for (size_t i = 0; i < m; i++) {
+                double av = 0.0;
+                for (size_t j = 0; j < n; j++) av += A->data[i][j] * svd->V->data[j][c];
+                double r = fabs(av - svd->values[c] * svd->U->data[i][c]);
+                if (r > residual) residual = r;
+            }
+        }
+        printf("Top singular values: %.6f %.6f (expected: %.6f %.6f)\n",
+               svd->values[0], svd->values[1], s[0], s[1]);
+        printf("Max relative singular value error: %.3e (expected: < 1e-8)\n", value_error);
+        printf("Max |A v - sigma u|: %.3e (expected: < 1e-8)\n", residual);
+    }
+
+    // Streaming from a matrix file gives the same answer
+    const char *path = "svd_test.fmat";
+    FloatSVD *streamed = NULL;
+    if (float_file_save(path, A) == 0) {
+        FloatMatrixFile *f = float_file_open(path, 0);
+        if (f != NULL) {
+            FloatRowSource file_source = float_row_source_file(f);
+            streamed = float_randomized_svd(&file_source, k, FLOAT_SVD_OVERSAMPLE, 2, 0, 99);
+            float_file_close(f);
+        }
+    }
+    remove(path);
+    if (svd != NULL && streamed != NULL) {
+        double diff = 0.0;
+        for (size_t c = 0; c < k; c++) {
+            if (fabs(svd->values[c] - streamed->values[c]) > diff) diff = fabs(svd->values[c] - streamed->values[c]);
+        }
+        printf("File-streamed vs in-memory singular values: %.3e (expected: 0)\n", diff);
+    }
+
+    dealloc_float_svd(svd);
+    dealloc_float_svd(streamed);
+    dealloc_float_matrix(V0t);
+    dealloc_float_matrix(U0);
+    dealloc_float_matrix(V0);
+    dealloc_float_matrix(A);
+}
+
+#ifndef NO_SVD_MAIN
+int main() {
+    printf("QR / Randomized SVD Test\n");
+    printf("========================\n");
+
+    test_float_qr();
+    test_float_randomized_svd();
+
+    printf("\n✓ All SVD tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,50 @@
+#ifndef FLOAT_SVD_H
+#define FLOAT_SVD_H
+
+#include <stdint.h>
+#include "float_matrix.h"
+#include "float_ooc.h"
+
+/* Rows of the tall matrix pulled into memory per pass step. */
+#define FLOAT_SVD_ROW_BLOCK 4096
+/* Suggested extra sketch columns beyond k. */
+#define FLOAT_SVD_OVERSAMPLE 10
+/* Sweep limit for the one-sided Jacobi SVD of the small factor. */
+#define FLOAT_SVD_JACOBI_SWEEPS 30
+
+/*
+ * Row-block access to an m x n matrix that need not fit in memory:
+ * read copies rows [first, first + count) into out (count x cols,
+ * row-major) and returns 0, or -1 on failure.
+ */
+typedef struct FloatRowSource {
+    size_t rows;
+    size_t cols;
+    int (*read)(void *context, size_t first, size_t count, double *out);
+    void *context;
+} FloatRowSource;
+
+/*
+ * Rank-k truncated SVD A ~ U diag(values) V^T, values descending.
+ * U (m x k) is only formed when asked for; V is n x k.
+ */
+typedef struct FloatSVD {
+    size_t k;
+    double *values;
+    FloatMatrix *U;
+    FloatMatrix *V;
+} FloatSVD;
+
+int float_qr(FloatMatrix *A, FloatMatrix **Q, FloatMatrix **R);
+
+FloatRowSource float_row_source_matrix(FloatMatrix *A);
+FloatRowSource float_row_source_file(FloatMatrixFile *f);
+
+FloatSVD* float_randomized_svd(FloatRowSource *source, size_t k, size_t oversample,
+                               size_t power_iterations, int want_u, uint64_t seed);
+void dealloc_float_svd(FloatSVD *svd);
+
+void test_float_qr(void);
+void test_float_randomized_svd(void);
+
+#endif
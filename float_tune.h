@@ -0,0 +1,55 @@
+#ifndef FLOAT_TUNE_H
+#define FLOAT_TUNE_H
+
+#include <stddef.h>
+
+/*
+ * Built-in defaults for the blocked kernels. A per-machine profile written
+ * by float_autotune overrides them; it is read from $MATRIX_TUNING_PROFILE
+ * or FLOAT_TUNING_DEFAULT_PATH the first time a kernel asks for its
+ * parameters.
+ */
+/* Cache blocking for float_gemm_kernel (rows of A, cols of B, shared dim). */
+#define FLOAT_GEMM_BLOCK_M 64
+#define FLOAT_GEMM_BLOCK_N 256
+#define FLOAT_GEMM_BLOCK_K 128
+/* Square tile edge for float_transpose. */
+#define FLOAT_TRANSPOSE_BLOCK 32
+/* Tile edge for the task-parallel LU and column chunk for multi-RHS solves. */
+#define FLOAT_LU_BLOCK 128
+/* Column tile edge and rows packed per panel for float_syrk. */
+#define FLOAT_SYRK_BLOCK 64
+#define FLOAT_SYRK_ROWS 256
+/*
+ * Kernels only fork threads once the work (in multiply-adds, or elements
+ * for the element-wise sweeps) reaches this. float_autotune measures it on
+ * GEMM alone; transpose, SYRK, the LU solves, activations and optimizer
+ * sweeps reuse that value, so for them it is an estimate.
+ */
+#define FLOAT_PARALLEL_THRESHOLD 1e6
+/* Largest block size a profile may set; bigger values keep the default. */
+#define FLOAT_TUNING_MAX_BLOCK 65536
+
+#define FLOAT_TUNING_DEFAULT_PATH "matrix_tuning.profile"
+
+typedef struct FloatTuning {
+    size_t gemm_block_m;
+    size_t gemm_block_n;
+    size_t gemm_block_k;
+    size_t transpose_block;
+    size_t lu_block;
+    size_t syrk_block;
+    double parallel_threshold;
+} FloatTuning;
+
+const FloatTuning* float_tuning(void);
+void float_tuning_defaults(FloatTuning *t);
+void float_tuning_set(const FloatTuning *t);
+int float_tuning_load(const char *path);
+int float_tuning_save(const char *path, const FloatTuning *t);
+void float_tuning_print(const FloatTuning *t);
+int float_autotune(const char *path, size_t size);
+
+void test_float_tuning_profile(void);
+
+#endif
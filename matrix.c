@@ -1,10 +1,90 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
 #include "matrix.h"
+#include "matrix_random.h"
+
+int matrix_size_mul(size_t a, size_t b, size_t *result) {
+  if (a != 0 && b > SIZE_MAX / a) {
+    return 0;
+  }
+  *result = a * b;
+  return 1;
+}
+
+/*
+ * Reference count stored in front of a handle's row-pointer array, so every
+ * handle sharing the storage sees the same count through its data pointer.
+ */
+typedef struct MatrixStorage {
+  size_t refs;
+  size_t borrowed;  // Elements belong to someone else; also keeps rows 16-byte aligned
+} MatrixStorage;
+
+static MatrixStorage *storage_of(void *rows) {
+  return (MatrixStorage *) rows - 1;
+}
+
+/* Row-pointer array of row_bytes with a count of one, or NULL. */
+void *matrix_storage_alloc(size_t row_bytes) {
+  if (row_bytes > SIZE_MAX - sizeof(MatrixStorage)) {
+    return NULL;
+  }
+  MatrixStorage *storage = (MatrixStorage *) malloc(sizeof(MatrixStorage) + row_bytes);
+  if (storage == NULL) {
+    return NULL;
+  }
+  storage->refs = 1;
+  storage->borrowed = 0;
+  return storage + 1;
+}
+
+/* Marks the elements behind rows as caller-owned: the last release will not ask for them to be freed. */
+void matrix_storage_borrow(void *rows) {
+  storage_of(rows)->borrowed = 1;
+}
+
+void matrix_storage_retain(void *rows) {
+  __atomic_fetch_add(&storage_of(rows)->refs, 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * Drops one reference; returns 1 when it was the last and the caller must
+ * free the elements (never for borrowed storage).
+ */
+int matrix_storage_release(void *rows) {
+  MatrixStorage *storage = storage_of(rows);
+  if (__atomic_fetch_sub(&storage->refs, 1, __ATOMIC_ACQ_REL) == 1) {
+    int owned = !storage->borrowed;
+    free(storage);
+    return owned;
+  }
+  return 0;
+}
+
+int matrix_storage_shared(void *rows) {
+  return __atomic_load_n(&storage_of(rows)->refs, __ATOMIC_ACQUIRE) > 1;
+}
+
+Matrix *create_matrix(size_t r, size_t c) {
+  size_t count, bytes, row_bytes;
+
+  if (r == 0 || c == 0) {
+    printf("Matrix dimensions must be positive\n");
+    return NULL;
+  }
+  if (!matrix_size_mul(r, c, &count) ||
+      !matrix_size_mul(count, sizeof(int), &bytes) ||
+      !matrix_size_mul(r, sizeof(int *), &row_bytes)) {
+    printf("Matrix of %zu x %zu elements is too large to allocate\n", r, c);
+    return NULL;
+  }
 
-Matrix *create_matrix(int r, int c) {
   Matrix *m = (Matrix *) malloc(sizeof(Matrix));
   if (m == NULL) {
     perror("Failed to allocate memory to the Matrix");
@@ -14,58 +94,47 @@ Matrix *create_matrix(int r, int c) {
   m->rows = r;
   m->cols = c;
 
-  m->data = (int **) malloc(r * sizeof(int *));
+  m->data = (int **) matrix_storage_alloc(row_bytes);
   if (m->data == NULL) {
     perror("Failed to allocate memory for data rows");
     free(m);
     return NULL;
   }
 
-  for (int i = 0; i < r; i++) {
-    m->data[i] = (int *) malloc(c * sizeof(int));
-    if (m->data[i] == NULL) {
-      perror("Failed to allocate memory for data columns");
-
-      for (int j = 0; j < i; j++) {
-        free(m->data[j]);
-      }
-      free(m->data);
-      free(m);
-      return NULL;
-    }
+  int *block = (int *) malloc(bytes);
+  if (block == NULL) {
+    perror("Failed to allocate memory for matrix elements");
+    matrix_storage_release(m->data);
+    free(m);
+    return NULL;
+  }
+  for (size_t i = 0; i < r; i++) {
+    m->data[i] = block + i * c;
   }
   return m;
 }
 
 void dealloc_matrix(Matrix *m) {
   if (m == NULL) return;
-  for (int i = 0; i < m->rows; i++) {
-    free(m->data[i]);
+  int *block = m->data[0];
+  if (matrix_storage_release(m->data)) {
+    free(block);
   }
-  free(m->data);
   free(m);
 }
 
 void init_zero(Matrix *m) {
-  for (int i = 0; i < m->rows; i++) {
-    for (int j = 0; j < m->cols; j++) {
+  if (matrix_make_writable(m) != 0) return;
+  for (size_t i = 0; i < m->rows; i++) {
+    for (size_t j = 0; j < m->cols; j++) {
       m->data[i][j] = 0;
     }
   }
 }
 
-void init_random(Matrix *m, int min_value, int max_value) {
-  for (int i = 0; i < m->rows; i++) {
-    for (int j = 0; j < m->cols; j++) {
-      int rand_val = rand() % (max_value - min_value + 1) + min_value;
-      m->data[i][j] = rand_val;
-    }
-  }
-}
-
 void matrix_print(Matrix *m) {
-  for (int i = 0; i < m->rows; i++) {
-    for (int j = 0; j < m->cols; j++) {
+  for (size_t i = 0; i < m->rows; i++) {
+    for (size_t j = 0; j < m->cols; j++) {
       printf("%d ", m->data[i][j]);
     }
     printf("\n");
@@ -73,6 +142,7 @@ void matrix_print(Matrix *m) {
   printf("\n");
 }
 
+/* Independent deep copy; share_matrix is enough when the copy is only read. */
 Matrix *dupe_matrix(Matrix *m) {
   Matrix *destination = create_matrix(m->rows, m->cols);
 
@@ -80,14 +150,45 @@ Matrix *dupe_matrix(Matrix *m) {
     return NULL;
   }
 
-  for (int i = 0; i < m->rows; i++) {
-    for (int j = 0; j < m->cols; j++) {
-      destination->data[i][j] = m->data[i][j];
-    }
-  }
+  memcpy(destination->data[0], m->data[0], m->rows * m->cols * sizeof(int));
   return destination;
 }
 
+/* New handle on m's storage: O(1), no element copy. */
+Matrix *share_matrix(Matrix *m) {
+  Matrix *handle = (Matrix *) malloc(sizeof(Matrix));
+  if (handle == NULL) {
+    perror("Failed to allocate memory to the Matrix");
+    return NULL;
+  }
+  matrix_storage_retain(m->data);
+  *handle = *m;
+  return handle;
+}
+
+/*
+ * Gives m storage of its own before a write. A no-op while m is the only
+ * handle; otherwise the elements are copied and m lets go of the shared
+ * storage. Returns 0, or -1 if the copy could not be allocated.
+ */
+int matrix_make_writable(Matrix *m) {
+  if (!matrix_storage_shared(m->data)) {
+    return 0;
+  }
+  Matrix *copy = dupe_matrix(m);
+  if (copy == NULL) {
+    return -1;
+  }
+  int **shared = m->data;
+  int *shared_block = shared[0];
+  m->data = copy->data;
+  free(copy);
+  if (matrix_storage_release(shared)) {
+    free(shared_block);
+  }
+  return 0;
+}
+
 Matrix *addition(Matrix *A, Matrix *B) {
   if (A->rows != B->rows || A->cols != B->cols) {
     printf("Needs to be the same dimensions\n");
@@ -99,8 +200,8 @@ Matrix *addition(Matrix *A, Matrix *B) {
     return NULL;
   }
 
-  for (int i = 0; i < A->rows; i++) {
-    for (int j = 0; j < A->cols; j++) {
+  for (size_t i = 0; i < A->rows; i++) {
+    for (size_t j = 0; j < A->cols; j++) {
       C->data[i][j] = A->data[i][j] + B->data[i][j];
     }
   }
@@ -114,8 +215,8 @@ Matrix *scalar_multiply(Matrix *m, int scalar) {
     return NULL;
   }
 
-  for (int i = 0; i < m->rows; i++) {
-    for (int j = 0; j < m->cols; j++) {
+  for (size_t i = 0; i < m->rows; i++) {
+    for (size_t j = 0; j < m->cols; j++) {
       result->data[i][j] = m->data[i][j] * scalar;
     }
   }
@@ -128,8 +229,8 @@ Matrix *transpose(Matrix *m) {
     return NULL;
   }
 
-  for (int i = 0; i < m->rows; i++) {
-    for (int j = 0; j < m->cols; j++) {
+  for (size_t i = 0; i < m->rows; i++) {
+    for (size_t j = 0; j < m->cols; j++) {
       result->data[j][i] = m->data[i][j];
     }
   }
@@ -138,17 +239,28 @@ Matrix *transpose(Matrix *m) {
 
 Matrix* multiply_matrix(Matrix *A, Matrix *B) {
   if (A->cols != B->rows) {
-    printf("Cannot multiply: A.cols (%d) != B.rows (%d)\n", A->cols, B->rows);
+    printf("Cannot multiply: A.cols (%zu) != B.rows (%zu)\n", A->cols, B->rows);
     return NULL;
   }
   Matrix *C = create_matrix(A->rows, B->cols);
   if (C == NULL) {
     return NULL;
   }
-  for (int i = 0; i < A->rows; i++) {
-    for (int j = 0; j < B->cols; j++) {
+  // A row vector streams B row by row instead of walking its columns
+  if (A->rows == 1) {
+    init_zero(C);
+    for (size_t k = 0; k < A->cols; k++) {
+      int a = A->data[0][k];
+      for (size_t j = 0; j < B->cols; j++) {
+        C->data[0][j] += a * B->data[k][j];
+      }
+    }
+    return C;
+  }
+  for (size_t i = 0; i < A->rows; i++) {
+    for (size_t j = 0; j < B->cols; j++) {
       int sum = 0;
-      for (int k = 0; k < A->cols; k++) {
+      for (size_t k = 0; k < A->cols; k++) {
         sum = sum + (A->data[i][k] * B->data[k][j]);
       }
       C->data[i][j] = sum;
@@ -157,53 +269,170 @@ Matrix* multiply_matrix(Matrix *A, Matrix *B) {
   return C;
 }
 
-double determinant(Matrix *m) {
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 bareiss_wide;
+#endif
+
+/*
+ * One Bareiss update, (a * b - c * d) / divisor, where divisor is the
+ * previous pivot and the division is exact. With 128-bit integers the
+ * product difference is formed wide and only the quotient has to fit in
+ * 64 bits; otherwise the products and difference themselves must fit.
+ * Returns 0 on overflow, 1 with *result set otherwise.
+ */
+static int bareiss_cross(long long a, long long b, long long c, long long d,
+                         long long divisor, long long *result) {
+#ifdef __SIZEOF_INT128__
+  bareiss_wide q = ((bareiss_wide)a * b - (bareiss_wide)c * d) / divisor;
+  if (q > LLONG_MAX || q < LLONG_MIN) {
+    return 0;
+  }
+  *result = (long long)q;
+  return 1;
+#else
+  long long ab, cd, diff;
+  if (__builtin_mul_overflow(a, b, &ab) || __builtin_mul_overflow(c, d, &cd) ||
+      __builtin_sub_overflow(ab, cd, &diff)) {
+    return 0;
+  }
+  *result = diff / divisor;
+  return 1;
+#endif
+}
+
+/*
+ * Exact determinant by Bareiss fraction-free elimination in O(n^3).
+ * Every intermediate is a minor of m, so each division is exact and the
+ * entries stay bounded by the largest minor (Hadamard's bound) rather than
+ * growing exponentially. Minors can still exceed |det| by far (det may be
+ * 0), so an intermediate can overflow even when the result would fit.
+ * Returns 0 on success, -1 if an intermediate does not fit in 64 bits.
+ */
+int determinant_exact(Matrix *m, long long *det) {
   if (m->rows != m->cols) {
     printf("Determinant undefined for non-square matrices\n");
-    return 0.0;
+    return -1;
   }
 
-  int n = m->rows;
-
-  if (n == 1) {
-    return (double)m->data[0][0];
+  size_t n = m->rows;
+  long long *a = (long long *) malloc(n * n * sizeof(long long));
+  if (a == NULL) {
+    perror("Failed to allocate memory for Bareiss elimination");
+    return -1;
   }
-  if (n == 2) {
-    return (double)(m->data[0][0] * m->data[1][1]) - (double)(m->data[0][1] * m->data[1][0]);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      a[i * n + j] = m->data[i][j];
+    }
   }
-  double det = 0.0;
 
-  for (int col = 0; col < n; col++) {
-    Matrix *submatrix = create_matrix(n - 1, n - 1);
-    if (submatrix == NULL) {
-      printf("Failed to create submatrix in determinant calculation\n");
-      return 0.0;
+  long long sign = 1, previous = 1;
+  int status = 0;
+  *det = 0;
+  for (size_t k = 0; k + 1 < n && status == 0; k++) {
+    if (a[k * n + k] == 0) {
+      size_t swap_row = k + 1;
+      while (swap_row < n && a[swap_row * n + k] == 0) {
+        swap_row++;
+      }
+      if (swap_row == n) {
+        free(a);
+        return 0;
+      }
+      for (size_t j = 0; j < n; j++) {
+        long long temp = a[k * n + j];
+        a[k * n + j] = a[swap_row * n + j];
+        a[swap_row * n + j] = temp;
+      }
+      sign = -sign;
     }
-    for (int i = 1; i < n; i++) {
-      int sub_j = 0;
-      for (int j = 0; j < n; j++) {
-        if (j != col) {
-          submatrix->data[i-1][sub_j] = m->data[i][j];
-          sub_j++;
+
+    long long pivot = a[k * n + k];
+    for (size_t i = k + 1; i < n && status == 0; i++) {
+      for (size_t j = k + 1; j < n; j++) {
+        if (!bareiss_cross(a[i * n + j], pivot, a[i * n + k], a[k * n + j],
+                           previous, &a[i * n + j])) {
+          status = -1;
+          break;
         }
       }
     }
-    double sign = (col % 2 == 0) ? 1.0 : -1.0;
-    double element = (double)m->data[0][col];
-    det += sign * element * determinant(submatrix);
+    previous = pivot;
+  }
+
+  if (status == 0) {
+    *det = sign * a[(n - 1) * n + (n - 1)];
+  }
+  free(a);
+  return status;
+}
 
-    dealloc_matrix(submatrix);
+/* Partially pivoted elimination in double, for when Bareiss overflows. */
+static double elimination_determinant(Matrix *m) {
+  size_t n = m->rows;
+  double *a = (double *) malloc(n * n * sizeof(double));
+  if (a == NULL) {
+    perror("Failed to allocate memory for determinant");
+    return 0.0;
+  }
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      a[i * n + j] = (double)m->data[i][j];
+    }
   }
 
+  double det = 1.0;
+  for (size_t k = 0; k < n; k++) {
+    size_t pivot_row = k;
+    for (size_t i = k + 1; i < n; i++) {
+      if (fabs(a[i * n + k]) > fabs(a[pivot_row * n + k])) {
+        pivot_row = i;
+      }
+    }
+    if (a[pivot_row * n + k] == 0.0) {
+      det = 0.0;
+      break;
+    }
+    if (pivot_row != k) {
+      for (size_t j = 0; j < n; j++) {
+        double temp = a[k * n + j];
+        a[k * n + j] = a[pivot_row * n + j];
+        a[pivot_row * n + j] = temp;
+      }
+      det = -det;
+    }
+    det *= a[k * n + k];
+    for (size_t i = k + 1; i < n; i++) {
+      double factor = a[i * n + k] / a[k * n + k];
+      for (size_t j = k + 1; j < n; j++) {
+        a[i * n + j] -= factor * a[k * n + j];
+      }
+    }
+  }
+
+  free(a);
   return det;
 }
 
+double determinant(Matrix *m) {
+  if (m->rows != m->cols) {
+    printf("Determinant undefined for non-square matrices\n");
+    return 0.0;
+  }
+
+  long long exact;
+  if (determinant_exact(m, &exact) == 0) {
+    return (double)exact;
+  }
+  return elimination_determinant(m);
+}
+
 Matrix* matrix_inverse(Matrix *m) {
     if (m->rows != m->cols) {
         printf("Cannot invert non-square matrix\n");
         return NULL;
     }
-    int n = m->rows;
+    size_t n = m->rows;
     double det = determinant(m);
     if (det == 0.0) {
         printf("Matrix is singular (determinant = 0), cannot be inverted\n");
@@ -213,21 +442,21 @@ Matrix* matrix_inverse(Matrix *m) {
     if (augmented == NULL) {
         return NULL;
     }
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
             augmented->data[i][j] = m->data[i][j];
         }
     }
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
             augmented->data[i][n + j] = (i == j) ? 1 : 0;
         }
     }
-    for (int col = 0; col < n; col++) {
-        int pivot_row = col;
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot_row = col;
         double max_val = fabs(augmented->data[col][col]);
 
-        for (int i = col + 1; i < n; i++) {
+        for (size_t i = col + 1; i < n; i++) {
             double abs_val = fabs(augmented->data[i][col]);
             if (abs_val > max_val) {
                 max_val = abs_val;
@@ -240,20 +469,20 @@ Matrix* matrix_inverse(Matrix *m) {
             return NULL;
         }
         if (pivot_row != col) {
-            for (int j = 0; j < 2 * n; j++) {
+            for (size_t j = 0; j < 2 * n; j++) {
                 int temp = augmented->data[col][j];
                 augmented->data[col][j] = augmented->data[pivot_row][j];
                 augmented->data[pivot_row][j] = temp;
             }
         }
         double pivot = augmented->data[col][col];
-        for (int j = 0; j < 2 * n; j++) {
+        for (size_t j = 0; j < 2 * n; j++) {
             augmented->data[col][j] = augmented->data[col][j] / pivot;
         }
-        for (int i = 0; i < n; i++) {
+        for (size_t i = 0; i < n; i++) {
             if (i != col) {
                 double factor = augmented->data[i][col];
-                for (int j = 0; j < 2 * n; j++) {
+                for (size_t j = 0; j < 2 * n; j++) {
                     augmented->data[i][j] = augmented->data[i][j] - (factor * augmented->data[col][j]);
                 }
             }
@@ -265,8 +494,8 @@ Matrix* matrix_inverse(Matrix *m) {
         return NULL;
     }
 
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
             inverse->data[i][j] = augmented->data[i][n + j];
         }
     }
@@ -275,6 +504,57 @@ Matrix* matrix_inverse(Matrix *m) {
     return inverse;
 }
 
+#ifdef MATRIX_COUNT_ALLOCS
+/*
+ * Test programs link with --wrap for malloc, calloc and realloc
+ * (TEST_FLAGS in the makefile), so every heap allocation made by library
+ * code passes through here. Allocations inside libc and the OpenMP
+ * runtime are not counted.
+ */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *p, size_t size);
+
+static long alloc_count = 0;
+
+void *__wrap_malloc(size_t size) {
+  __atomic_add_fetch(&alloc_count, 1, __ATOMIC_RELAXED);
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  __atomic_add_fetch(&alloc_count, 1, __ATOMIC_RELAXED);
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *p, size_t size) {
+  __atomic_add_fetch(&alloc_count, 1, __ATOMIC_RELAXED);
+  return __real_realloc(p, size);
+}
+
+long matrix_alloc_count(void) {
+  return __atomic_load_n(&alloc_count, __ATOMIC_RELAXED);
+}
+#else
+long matrix_alloc_count(void) {
+  return -1;
+}
+#endif
+
+/*
+ * Checks that no heap allocation happened since before, a
+ * matrix_alloc_count() reading taken at the start of what.
+ */
+void matrix_expect_no_allocs(long before, const char *what) {
+  long now = matrix_alloc_count();
+  if (before < 0 || now < 0) {
+    printf("Heap allocations over %s: not counted in this build\n", what);
+    return;
+  }
+  printf("Heap allocations over %s: %ld (expected: 0)\n", what, now - before);
+  assert(now == before);
+}
+
 void test_addition() {
   Matrix *A = create_matrix(2, 2);
   Matrix *B = create_matrix(2, 2);
@@ -328,6 +608,45 @@ void test_determinant() {
     dealloc_matrix(m3);
 }
 
+void test_determinant_exact() {
+    printf("\n=== Testing Exact Determinant (Bareiss) ===\n");
+
+    // L * U with unit L, so det = 1000003 * 999983 * 1000033 (> 2^53)
+    Matrix *m = create_matrix(3, 3);
+    m->data[0][0] = 1000003;  m->data[0][1] = 5;       m->data[0][2] = 7;
+    m->data[1][0] = 2000006;  m->data[1][1] = 999993;  m->data[1][2] = 3;
+    m->data[2][0] = -3000009; m->data[2][1] = 3999917; m->data[2][2] = 999968;
+
+    long long det = 0;
+    if (determinant_exact(m, &det) == 0) {
+        printf("Determinant: %lld (expected: 1000018999486998317)\n", det);
+    }
+    dealloc_matrix(m);
+
+    // Zero leading pivot forces a row swap
+    Matrix *p = create_matrix(3, 3);
+    p->data[0][0] = 0; p->data[0][1] = 1; p->data[0][2] = 1;
+    p->data[1][0] = 1; p->data[1][1] = 0; p->data[1][2] = 1;
+    p->data[2][0] = 1; p->data[2][1] = 1; p->data[2][2] = 0;
+    if (determinant_exact(p, &det) == 0) {
+        printf("Incidence matrix determinant: %lld (expected: 2)\n", det);
+    }
+    dealloc_matrix(p);
+
+    // Result far beyond 64 bits must be reported, not wrapped
+    Matrix *big = create_matrix(3, 3);
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            big->data[i][j] = (i == j) ? INT_MAX : 0;
+        }
+    }
+    printf("Overflow detected: %s (expected: yes)\n",
+           determinant_exact(big, &det) != 0 ? "yes" : "no");
+    printf("Double fallback: %.6e (expected: %.6e)\n",
+           determinant(big), (double)INT_MAX * INT_MAX * INT_MAX);
+    dealloc_matrix(big);
+}
+
 void test_inverse() {
     printf("\n=== Testing Matrix Inverse ===\n");
 
@@ -387,9 +706,62 @@ void test_multiply() {
     dealloc_matrix(A);
     dealloc_matrix(B);
 }
+void test_allocation_limits() {
+    printf("\n=== Testing Allocation Limits ===\n");
+
+    // rows * cols * sizeof(int) wraps around size_t and must be refused
+    Matrix *huge = create_matrix(SIZE_MAX / 2, 4);
+    printf("Overflowing allocation: %s (expected: rejected)\n",
+           huge == NULL ? "rejected" : "accepted");
+    dealloc_matrix(huge);
+
+    Matrix *m = create_matrix(3, 4);
+    if (m != NULL) {
+        init_zero(m);
+        m->data[2][3] = 7;
+        printf("Contiguous rows: %s (expected: yes)\n",
+               (&m->data[0][0] + 2 * 4 + 3 == &m->data[2][3]) ? "yes" : "no");
+        dealloc_matrix(m);
+    }
+}
+void test_shared_matrix() {
+    printf("\n=== Testing Copy-on-Write Sharing ===\n");
+
+    Matrix *original = create_matrix(3, 3);
+    if (original == NULL) return;
+    init_zero(original);
+    original->data[1][1] = 5;
+
+    Matrix *shared = share_matrix(original);
+    if (shared == NULL) {
+        dealloc_matrix(original);
+        return;
+    }
+    printf("Shared handle reuses storage: %s (expected: yes)\n",
+           shared->data == original->data ? "yes" : "no");
+
+    if (matrix_make_writable(shared) == 0) {
+        shared->data[1][1] = 9;
+    }
+    printf("After write: original %d, shared %d (expected: 5, 9)\n",
+           original->data[1][1], shared->data[1][1]);
+
+    // original is the only handle again, so this write must not copy
+    int **before = original->data;
+    matrix_make_writable(original);
+    printf("Sole handle writes in place: %s (expected: yes)\n",
+           original->data == before ? "yes" : "no");
+
+    Matrix *reader = share_matrix(original);
+    dealloc_matrix(original);
+    printf("Storage outlives the first handle: %d (expected: 5)\n",
+           reader != NULL ? reader->data[1][1] : -1);
+    dealloc_matrix(reader);
+    dealloc_matrix(shared);
+}
 #ifndef NO_MATRIX_MAIN
 int main() {
-  srand(time(NULL));
+  matrix_random_seed((uint64_t)time(NULL));
 
   printf("Matrix Library Test Suite\n");
   printf("===========================\n");
@@ -397,7 +769,10 @@ int main() {
   test_addition();
   test_multiply();
   test_determinant();
+  test_determinant_exact();
   test_inverse();
+  test_allocation_limits();
+  test_shared_matrix();
 
   printf("\n✓ All tests completed!\n");
   return 0;
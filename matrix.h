@@ -1,18 +1,45 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <stddef.h>
+
+/*
+ * Elements live in one contiguous row-major block; data[i] points at row i.
+ * The storage is reference counted: share_matrix returns another handle to
+ * it in O(1) and dealloc_matrix frees it with the last handle. Code that
+ * writes through data must call matrix_make_writable first, which copies
+ * the storage only while another handle still shares it (copy-on-write).
+ */
 typedef struct Matrix {
-    int rows;
-    int cols;
+    size_t rows;
+    size_t cols;
     int **data;
 } Matrix;
 
-Matrix* create_matrix(int r, int c);
+int matrix_size_mul(size_t a, size_t b, size_t *result);
+void* matrix_storage_alloc(size_t row_bytes);
+void matrix_storage_borrow(void *rows);
+void matrix_storage_retain(void *rows);
+int matrix_storage_release(void *rows);
+int matrix_storage_shared(void *rows);
+
+Matrix* create_matrix(size_t r, size_t c);
 void dealloc_matrix(Matrix *m);
 void init_zero(Matrix *m);
 void init_random(Matrix *m, int min_value, int max_value);
 void matrix_print(Matrix *m);
 Matrix* dupe_matrix(Matrix *m);
+Matrix* share_matrix(Matrix *m);
+int matrix_make_writable(Matrix *m);
+
+/*
+ * Heap allocations made by library code so far, or -1 unless built with
+ * MATRIX_COUNT_ALLOCS and the matching --wrap link flags (the test
+ * programs are). Tests of allocation-free paths use
+ * matrix_expect_no_allocs.
+ */
+long matrix_alloc_count(void);
+void matrix_expect_no_allocs(long before, const char *what);
 
 Matrix* addition(Matrix *A, Matrix *B);
 Matrix* scalar_multiply(Matrix *m, int scalar);
@@ -20,11 +47,15 @@ Matrix* transpose(Matrix *m);
 Matrix* multiply_matrix(Matrix *A, Matrix *B);
 
 double determinant(Matrix *m);
+int determinant_exact(Matrix *m, long long *det);
 Matrix* matrix_inverse(Matrix *m);
 
 void test_addition(void);
 void test_multiply(void);
 void test_determinant(void);
+void test_determinant_exact(void);
 void test_inverse(void);
+void test_allocation_limits(void);
+void test_shared_matrix(void);
 
 #endif
\ No newline at end of file
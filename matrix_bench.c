@@ -0,0 +1,1067 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "float_matrix.h"
+#include "float_lu.h"
+#include "float_expr.h"
+#include "float_tune.h"
+#include "float_numa.h"
+#include "matrix_random.h"
+#include "float_eigen.h"
+#include "float_svd.h"
+#include "float_mlp.h"
+#include "float_optim.h"
+#include "float_dp.h"
+#include "float_rnn.h"
+#include "float_conv.h"
+#include "float_checkpoint.h"
+#include "activ_func/nn_func.h"
+
+/*
+ * Benchmark suite. Run every case, or one by name with an optional size:
+ *   ./matrix_bench            all cases except autotune at their default sizes
+ *   ./matrix_bench lu 4096    tiled LU scaling on a 4096 x 4096 matrix
+ *   ./matrix_bench expr 2048  fused vs eager element-wise chain
+ *   ./matrix_bench numa 8192  triad bandwidth with and without NUMA placement
+ *   ./matrix_bench random     rand() loop vs blocked xoshiro fills
+ *   ./matrix_bench eigen 5000 top-10 eigenpairs of a random symmetric matrix
+ *   ./matrix_bench pca        principal components of the 20-ticker daily returns
+ *   ./matrix_bench svd 200000 rank-20 SVD of a generated 200000 x 500 row stream
+ *   ./matrix_bench activ      libm vs fast approximate sigmoid/tanh/exp over 4M elements
+ *   ./matrix_bench softmax 50000  fused vs two-pass softmax cross-entropy, 512 rows
+ *   ./matrix_bench mlp 1024   MLP training throughput by mini-batch size, 1024-wide layers
+ *   ./matrix_bench optim 10000000  fused vs one-pass-per-term Adam update over 10M parameters
+ *   ./matrix_bench dp 512     data-parallel training throughput by thread count, 512-wide layers
+ *   ./matrix_bench rnn 128    LSTM/GRU over 20-ticker return windows: chunked vs per-step input GEMM
+ *   ./matrix_bench conv 64    Conv1D over the OHLCV series of all 20 tickers, 64 filters
+ *   ./matrix_bench checkpoint 4096  save, mmap open and copying load of a 4096-wide MLP (~400 MB)
+ *   ./matrix_bench autotune   sweep block sizes and write the tuning profile
+ */
+
+#define BENCH_MAX_THREADS 64
+
+/* Deterministic pseudo-random fill in [-0.5, 0.5). */
+static void fill_test_matrix(FloatMatrix *m, size_t seed) {
+    for (size_t i = 0; i < m->rows; i++) {
+        for (size_t j = 0; j < m->cols; j++) {
+            unsigned long long h = (unsigned long long)(i * m->cols + j) * 0x9E3779B97F4A7C15ULL + seed;
+            h ^= h >> 31;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h >> 29;
+            m->data[i][j] = (double)(h % 1000003ULL) / 1000003.0 - 0.5;
+        }
+    }
+}
+
+static void set_threads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+static int max_bench_threads(void) {
+#ifdef _OPENMP
+    return BENCH_MAX_THREADS;
+#else
+    return 1;
+#endif
+}
+
+static void bench_lu_scaling(size_t n) {
+    printf("\n=== Tiled LU scaling (n = %zu, tile = %zu) ===\n", n, float_tuning()->lu_block);
+
+    FloatMatrix *A = create_float_matrix(n, n);
+    FloatMatrix *work = create_float_matrix(n, n);
+    size_t *pivots = (size_t *)malloc(n * sizeof(size_t));
+    if (A == NULL || work == NULL || pivots == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(work);
+        free(pivots);
+        return;
+    }
+    fill_test_matrix(A, 1);
+
+    double flops = 2.0 / 3.0 * (double)n * (double)n * (double)n;
+    double base_seconds = 0.0;
+    printf("%8s %10s %10s %8s\n", "threads", "seconds", "GFLOP/s", "speedup");
+    for (int threads = 1; threads <= max_bench_threads(); threads *= 2) {
+        set_threads(threads);
+        memcpy(work->data[0], A->data[0], n * n * sizeof(double));
+        int sign;
+        double start = float_wall_seconds();
+        int status = float_lu_decompose(work->data[0], n, pivots, &sign);
+        double seconds = float_wall_seconds() - start;
+        if (status != 0) {
+            printf("Benchmark matrix is singular\n");
+            break;
+        }
+        if (threads == 1) base_seconds = seconds;
+        printf("%8d %10.4f %10.2f %8.2fx\n", threads, seconds, flops / seconds / 1e9, base_seconds / seconds);
+    }
+
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(work);
+    free(pivots);
+}
+
+/*
+ * 8-op chain ((((2A + B) * 0.5 + C) * 1.5 + D) * 0.25 + A). Eagerly every
+ * scale reads and writes n^2 doubles and every add reads two and writes
+ * one; fused, the five leaf reads and one result write are all that
+ * reaches memory.
+ */
+static void bench_expr_fusion(size_t n) {
+    printf("\n=== Fused element-wise chain (%zu x %zu, 8 ops) ===\n", n, n);
+
+    FloatMatrix *A = create_float_matrix(n, n);
+    FloatMatrix *B = create_float_matrix(n, n);
+    FloatMatrix *C = create_float_matrix(n, n);
+    FloatMatrix *D = create_float_matrix(n, n);
+    if (A == NULL || B == NULL || C == NULL || D == NULL) {
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        dealloc_float_matrix(C);
+        dealloc_float_matrix(D);
+        return;
+    }
+    fill_test_matrix(A, 1);
+    fill_test_matrix(B, 2);
+    fill_test_matrix(C, 3);
+    fill_test_matrix(D, 4);
+
+    FloatMatrix *leaves[4] = { B, C, D, A };
+    double scales[4] = { 2.0, 0.5, 1.5, 0.25 };
+
+    double start = float_wall_seconds();
+    FloatMatrix *eager = float_scalar_multiply(A, scales[0]);
+    for (int step = 0; step < 4 && eager != NULL; step++) {
+        FloatMatrix *sum = float_addition(eager, leaves[step]);
+        dealloc_float_matrix(eager);
+        eager = NULL;
+        if (sum != NULL && step < 3) {
+            eager = float_scalar_multiply(sum, scales[step + 1]);
+            dealloc_float_matrix(sum);
+        } else {
+            eager = sum;
+        }
+    }
+    double eager_seconds = float_wall_seconds() - start;
+
+    start = float_wall_seconds();
+    FloatExpr *e = float_expr_scale(float_expr_leaf(A), scales[0]);
+    for (int step = 0; step < 4; step++) {
+        e = float_expr_add(e, float_expr_leaf(leaves[step]));
+        if (step < 3) {
+            e = float_expr_scale(e, scales[step + 1]);
+        }
+    }
+    FloatMatrix *fused = float_expr_eval(e);
+    double fused_seconds = float_wall_seconds() - start;
+
+    double elems = (double)n * (double)n;
+    double eager_bytes = 8.0 * elems * (4 * 2 + 4 * 3);
+    double fused_bytes = 8.0 * elems * (5 + 1);
+    printf("%8s %10s %12s %10s\n", "mode", "seconds", "traffic MB", "GB/s");
+    printf("%8s %10.4f %12.1f %10.2f\n", "eager", eager_seconds, eager_bytes / 1e6, eager_bytes / eager_seconds / 1e9);
+    printf("%8s %10.4f %12.1f %10.2f\n", "fused", fused_seconds, fused_bytes / 1e6, fused_bytes / fused_seconds / 1e9);
+    printf("Traffic reduction: %.1fx, speedup: %.2fx\n", eager_bytes / fused_bytes, eager_seconds / fused_seconds);
+
+    if (eager != NULL && fused != NULL) {
+        double max_diff = 0.0;
+        for (size_t i = 0; i < n * n; i++) {
+            double diff = fabs(eager->data[0][i] - fused->data[0][i]);
+            if (diff > max_diff) max_diff = diff;
+        }
+        printf("Max difference eager vs fused: %.3e\n", max_diff);
+    }
+
+    dealloc_float_expr(e);
+    dealloc_float_matrix(eager);
+    dealloc_float_matrix(fused);
+    dealloc_float_matrix(A);
+    dealloc_float_matrix(B);
+    dealloc_float_matrix(C);
+    dealloc_float_matrix(D);
+}
+
+/*
+ * STREAM-style triad C = A + 0.5 B over n x n matrices, with each row
+ * range handled by the thread that a static schedule gives it. In the
+ * default run the inputs are filled by the main thread, so all pages sit
+ * on its node; the placed runs first-touch (or interleave) them across
+ * nodes and pin the pool threads. On a single-node machine the modes
+ * should match.
+ */
+static void bench_numa_placement(size_t n) {
+    printf("\n=== NUMA placement, triad bandwidth (%zu x %zu, %d node(s)) ===\n", n, n, float_numa_nodes());
+
+    static const FloatPlacement modes[] = {
+        FLOAT_PLACEMENT_DEFAULT, FLOAT_PLACEMENT_FIRST_TOUCH, FLOAT_PLACEMENT_INTERLEAVE
+    };
+    static const char *names[] = { "default", "first-touch", "interleave" };
+    double base_seconds = 0.0;
+
+    printf("%12s %7s %10s %10s %8s\n", "placement", "pinned", "seconds", "GB/s", "speedup");
+    for (int m = 0; m < 3; m++) {
+        float_set_placement(modes[m]);
+        int pinned = modes[m] != FLOAT_PLACEMENT_DEFAULT ? float_pin_threads() : 0;
+
+        FloatMatrix *A = create_float_matrix(n, n);
+        FloatMatrix *B = create_float_matrix(n, n);
+        FloatMatrix *C = create_float_matrix(n, n);
+        if (A == NULL || B == NULL || C == NULL) {
+            dealloc_float_matrix(A);
+            dealloc_float_matrix(B);
+            dealloc_float_matrix(C);
+            float_unpin_threads();
+            break;
+        }
+        fill_test_matrix(A, 1);
+        fill_test_matrix(B, 2);
+        init_float_zero(C);
+
+        long rows = (long)n;
+        double best = -1.0;
+        for (int rep = 0; rep < 5; rep++) {
+            double start = float_wall_seconds();
+            #pragma omp parallel for schedule(static)
+            for (long i = 0; i < rows; i++) {
+                const double *a = A->data[i], *b = B->data[i];
+                double *c = C->data[i];
+                #pragma omp simd
+                for (size_t j = 0; j < n; j++) {
+                    c[j] = a[j] + 0.5 * b[j];
+                }
+            }
+            double seconds = float_wall_seconds() - start;
+            if (best < 0.0 || seconds < best) best = seconds;
+        }
+        if (m == 0) base_seconds = best;
+        double bytes = 3.0 * 8.0 * (double)n * (double)n;
+        printf("%12s %7d %10.4f %10.2f %8.2fx\n", names[m], pinned, best, bytes / best / 1e9, base_seconds / best);
+
+        dealloc_float_matrix(A);
+        dealloc_float_matrix(B);
+        dealloc_float_matrix(C);
+        float_unpin_threads();
+    }
+    float_set_placement(FLOAT_PLACEMENT_DEFAULT);
+}
+
+/* Per-element rand() (the old init path) against the blocked generator fills. */
+static void bench_random_fill(size_t n) {
+    printf("\n=== Random fill (%zu x %zu) ===\n", n, n);
+
+    FloatMatrix *m = create_float_matrix(n, n);
+    if (m == NULL) {
+        return;
+    }
+    double elems = (double)n * (double)n;
+
+    double start = float_wall_seconds();
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            m->data[i][j] = (double)rand() / ((double)RAND_MAX + 1.0);
+        }
+    }
+    double rand_seconds = float_wall_seconds() - start;
+
+    start = float_wall_seconds();
+    float_fill_uniform(m, 0.0, 1.0, 1);
+    double uniform_seconds = float_wall_seconds() - start;
+
+    start = float_wall_seconds();
+    float_fill_normal(m, 0.0, 1.0, 1);
+    double normal_seconds = float_wall_seconds() - start;
+
+    printf("%16s %10s %14s %8s\n", "fill", "seconds", "Melem/s", "speedup");
+    printf("%16s %10.4f %14.1f %8.2fx\n", "rand() uniform", rand_seconds, elems / rand_seconds / 1e6, 1.0);
+    printf("%16s %10.4f %14.1f %8.2fx\n", "xoshiro uniform", uniform_seconds, elems / uniform_seconds / 1e6, rand_seconds / uniform_seconds);
+    printf("%16s %10.4f %14.1f %8.2fx\n", "xoshiro normal", normal_seconds, elems / normal_seconds / 1e6, rand_seconds / normal_seconds);
+
+    dealloc_float_matrix(m);
+}
+
+static void bench_eigen_scaling(size_t n) {
+    printf("\n=== Symmetric eigensolver, top 10 of %zu x %zu ===\n", n, n);
+
+    FloatMatrix *A = create_float_matrix(n, n);
+    if (A == NULL) {
+        return;
+    }
+    float_fill_uniform(A, -1.0, 1.0, 5);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < i; j++) {
+            A->data[i][j] = A->data[j][i];
+        }
+    }
+
+    double base_seconds = 0.0;
+    printf("%8s %10s %8s %14s\n", "threads", "seconds", "speedup", "lambda_max");
+    for (int threads = 1; threads <= max_bench_threads(); threads *= 2) {
+        set_threads(threads);
+        double start = float_wall_seconds();
+        FloatEigen *eigen = float_eigen_symmetric(A, n < 10 ? n : 10);
+        double seconds = float_wall_seconds() - start;
+        if (eigen == NULL) {
+            break;
+        }
+        if (threads == 1) base_seconds = seconds;
+        printf("%8d %10.4f %8.2fx %14.6f\n", threads, seconds, base_seconds / seconds, eigen->values[0]);
+        dealloc_float_eigen(eigen);
+    }
+
+    dealloc_float_matrix(A);
+}
+
+/*
+ * Every field of the combined CSV (three header rows, then a date and
+ * Open, High, Low, Close, Volume per ticker) for the days where all of
+ * them parse. Returns a days x (5 * tickers) matrix, or NULL if the file
+ * cannot be read.
+ */
+static FloatMatrix* load_stock_fields(const char *path, size_t *tickers_out) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("Could not open %s\n", path);
+        return NULL;
+    }
+
+    static char line[1 << 16];
+    size_t tickers = 0, days = 0, capacity = 0;
+    double *fields = NULL;
+    int row = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (row++ == 0) {
+            for (char *c = line; *c != '\0'; c++) {
+                if (*c == ',') tickers++;
+            }
+            tickers /= 5;
+            continue;
+        }
+        if (row <= 3 || tickers == 0) {
+            continue;
+        }
+        if ((days + 1) * 5 * tickers > capacity) {
+            capacity = capacity ? 2 * capacity : 512 * 5 * tickers;
+            double *grown = (double *)realloc(fields, capacity * sizeof(double));
+            if (grown == NULL) {
+                free(fields);
+                fclose(file);
+                return NULL;
+            }
+            fields = grown;
+        }
+
+        char *field = strchr(line, ',');
+        size_t column = 0;
+        int complete = 1;
+        while (field != NULL && column < 5 * tickers) {
+            char *end;
+            double value = strtod(field + 1, &end);
+            if (end == field + 1) complete = 0;
+            fields[days * 5 * tickers + column] = value;
+            field = strchr(field + 1, ',');
+            column++;
+        }
+        if (complete && column == 5 * tickers) {
+            days++;
+        }
+    }
+    fclose(file);
+
+    FloatMatrix *table = (days > 0) ? create_float_matrix(days, 5 * tickers) : NULL;
+    if (table != NULL) {
+        memcpy(table->data[0], fields, days * 5 * tickers * sizeof(double));
+    }
+    free(fields);
+    *tickers_out = tickers;
+    return table;
+}
+
+/*
+ * Daily close-to-close returns of every ticker in the combined CSV.
+ * Returns a days x tickers matrix, or NULL if the file cannot be read.
+ */
+static FloatMatrix* load_close_returns(const char *path, size_t *tickers_out) {
+    size_t tickers = 0;
+    FloatMatrix *table = load_stock_fields(path, &tickers);
+    if (table == NULL) {
+        return NULL;
+    }
+    size_t days = table->rows;
+    FloatMatrix *returns = (days >= 3) ? create_float_matrix(days - 1, tickers) : NULL;
+    for (size_t d = 1; returns != NULL && d < days; d++) {
+        for (size_t t = 0; t < tickers; t++) {
+            returns->data[d - 1][t] = table->data[d][5 * t + 3] / table->data[d - 1][5 * t + 3] - 1.0;
+        }
+    }
+    dealloc_float_matrix(table);
+    *tickers_out = tickers;
+    return returns;
+}
+
+static void bench_pca_stocks(size_t components) {
+    const char *path = "CSV/all_stocks_combined.csv";
+    size_t tickers = 0;
+    FloatMatrix *returns = load_close_returns(path, &tickers);
+    if (returns == NULL) {
+        return;
+    }
+    if (components == 0 || components > tickers) {
+        components = tickers;
+    }
+    printf("\n=== PCA of daily returns (%zu days x %zu tickers) ===\n", returns->rows, tickers);
+
+    double start = float_wall_seconds();
+    FloatEigen *pca = float_pca(returns, components);
+    double seconds = float_wall_seconds() - start;
+    FloatMatrix *full = pca != NULL ? float_covariance(returns) : NULL;
+    if (pca != NULL && full != NULL) {
+        double total = 0.0;
+        for (size_t t = 0; t < tickers; t++) total += full->data[t][t];
+        printf("%10s %14s %12s\n", "component", "variance", "explained");
+        double cumulative = 0.0;
+        for (size_t c = 0; c < components; c++) {
+            cumulative += pca->values[c] / total;
+            printf("%10zu %14.3e %11.1f%%\n", c + 1, pca->values[c], 100.0 * cumulative);
+        }
+
+        FloatMatrix *scores = float_pca_project(returns, pca);
+        if (scores != NULL) {
+            printf("First-day scores on PC1/PC2: %.4f %.4f\n", scores->data[0][0],
+                   components > 1 ? scores->data[0][1] : 0.0);
+            dealloc_float_matrix(scores);
+        }
+        printf("Covariance + eigensolve: %.4f s\n", seconds);
+    }
+
+    dealloc_float_matrix(full);
+    dealloc_float_eigen(pca);
+    dealloc_float_matrix(returns);
+}
+
+/*
+ * Rows of a synthetic m x n matrix with rank-30 structure plus noise,
+ * generated on demand so the full matrix is never materialised.
+ */
+typedef struct GeneratedRows {
+    size_t cols;
+    size_t rank;
+    FloatMatrix *factors;  // rank x cols, row c scaled by 0.8^c
+} GeneratedRows;
+
+static int read_generated_rows(void *context, size_t first, size_t count, double *out) {
+    GeneratedRows *g = (GeneratedRows *)context;
+    for (size_t r = 0; r < count; r++) {
+        double *row = out + r * g->cols;
+        for (size_t j = 0; j < g->cols; j++) {
+            unsigned long long h = (unsigned long long)((first + r) * g->cols + j) * 0x9E3779B97F4A7C15ULL;
+            h ^= h >> 29;
+            row[j] = 1e-3 * ((double)(h % 1000003ULL) / 1000003.0 - 0.5);
+        }
+        for (size_t c = 0; c < g->rank; c++) {
+            double weight = sin(0.37 * (double)(first + r) * (double)(c + 1) + (double)c);
+            const double *factor = g->factors->data[c];
+            for (size_t j = 0; j < g->cols; j++) {
+                row[j] += weight * factor[j];
+            }
+        }
+    }
+    return 0;
+}
+
+static void bench_randomized_svd(size_t m) {
+    size_t n = 500, k = 20;
+    printf("\n=== Randomized SVD, rank %zu of a streamed %zu x %zu matrix ===\n", k, m, n);
+
+    GeneratedRows generated = { n, 30, create_float_matrix(30, n) };
+    if (generated.factors == NULL) {
+        return;
+    }
+    float_fill_normal(generated.factors, 0.0, 1.0, 8);
+    for (size_t c = 0; c < generated.rank; c++) {
+        for (size_t j = 0; j < n; j++) generated.factors->data[c][j] *= pow(0.8, (double)c);
+    }
+    FloatRowSource source = { m, n, read_generated_rows, &generated };
+
+    printf("%6s %10s %14s %14s\n", "power", "seconds", "sigma_1", "sigma_k");
+    for (size_t power = 0; power <= 2; power++) {
+        double start = float_wall_seconds();
+        FloatSVD *svd = float_randomized_svd(&source, k, FLOAT_SVD_OVERSAMPLE, power, 0, 21);
+        double seconds = float_wall_seconds() - start;
+        if (svd == NULL) {
+            break;
+        }
+        printf("%6zu %10.3f %14.6f %14.6f\n", power, seconds, svd->values[0], svd->values[k - 1]);
+        dealloc_float_svd(svd);
+    }
+    printf("Resident: one %d-row block and the %zu x %zu sketch; full matrix would be %.1f MB\n",
+           FLOAT_SVD_ROW_BLOCK, n, k + FLOAT_SVD_OVERSAMPLE, 8.0 * (double)m * (double)n / 1e6);
+
+    dealloc_float_matrix(generated.factors);
+}
+
+/*
+ * Adam written the way a tensor library would run it: one element-wise
+ * pass per term, each re-reading its operands from memory.
+ */
+static void adam_unfused(double *p, const double *g, double *m, double *v, double *scratch,
+                         size_t n, double lr, uint64_t step) {
+    double c1 = 1.0 / (1.0 - pow(FLOAT_OPTIM_ADAM_BETA1, (double)step));
+    double c2 = 1.0 / (1.0 - pow(FLOAT_OPTIM_ADAM_BETA2, (double)step));
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long)n; i++) m[i] = FLOAT_OPTIM_ADAM_BETA1 * m[i] + (1.0 - FLOAT_OPTIM_ADAM_BETA1) * g[i];
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long)n; i++) v[i] = FLOAT_OPTIM_ADAM_BETA2 * v[i] + (1.0 - FLOAT_OPTIM_ADAM_BETA2) * g[i] * g[i];
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long)n; i++) scratch[i] = sqrt(v[i] * c2) + FLOAT_OPTIM_EPSILON;
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long)n; i++) scratch[i] = m[i] * c1 / scratch[i];
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long)n; i++) p[i] -= lr * scratch[i];
+}
+
+static void bench_optimizers(size_t n) {
+    printf("\n=== Adam update over %zu parameters ===\n", n);
+
+    FloatMatrix *buffers = create_float_matrix(5, n);
+    FloatOptimizer *adam = float_optim_adam(n, 1e-3, FLOAT_OPTIM_ADAM_BETA1, FLOAT_OPTIM_ADAM_BETA2,
+                                            FLOAT_OPTIM_EPSILON);
+    if (buffers == NULL || adam == NULL) {
+        dealloc_float_matrix(buffers);
+        dealloc_float_optimizer(adam);
+        return;
+    }
+    float_fill_normal(buffers, 0.0, 1.0, 12);
+    double *p = buffers->data[0], *g = buffers->data[1];
+    double *m = buffers->data[2], *v = buffers->data[3], *scratch = buffers->data[4];
+    memset(m, 0, 2 * n * sizeof(double));
+
+    int steps = 5;
+    printf("%8s %14s %14s %8s\n", "threads", "unfused Mp/s", "fused Mp/s", "speedup");
+    for (int threads = 1; threads <= max_bench_threads(); threads *= 2) {
+        set_threads(threads);
+
+        double start = float_wall_seconds();
+        for (int step = 1; step <= steps; step++) {
+            adam_unfused(p, g, m, v, scratch, n, 1e-3, (uint64_t)step);
+        }
+        double unfused = float_wall_seconds() - start;
+
+        float_optim_reset(adam);
+        start = float_wall_seconds();
+        for (int step = 0; step < steps; step++) {
+            float_optim_step(adam, p, g);
+        }
+        double fused = float_wall_seconds() - start;
+
+        double params = (double)n * steps / 1e6;
+        printf("%8d %14.1f %14.1f %8.2fx\n", threads, params / unfused, params / fused, unfused / fused);
+    }
+
+    dealloc_float_optimizer(adam);
+    dealloc_float_matrix(buffers);
+}
+
+/*
+ * Times the kernels over their block-size candidates at edge n and saves
+ * the fastest settings to $MATRIX_TUNING_PROFILE (or the default path),
+ * where every later run picks them up at startup.
+ */
+static void bench_autotune(size_t n) {
+    const char *path = getenv("MATRIX_TUNING_PROFILE");
+    if (path == NULL) {
+        path = FLOAT_TUNING_DEFAULT_PATH;
+    }
+    printf("\n=== Autotuning kernels (n = %zu) ===\n", n);
+
+    FloatTuning before = *float_tuning();
+    printf("Before:\n");
+    float_tuning_print(&before);
+
+    double start = float_wall_seconds();
+    if (float_autotune(path, n) != 0) {
+        printf("Autotuning failed\n");
+        return;
+    }
+    printf("After (%.1f s, saved to %s):\n", float_wall_seconds() - start, path);
+    float_tuning_print(float_tuning());
+}
+
+/*
+ * Softmax cross-entropy over 512 rows of n classes: the fused kernel
+ * against softmax into a buffer followed by a separate loss/gradient
+ * pass, from 1 thread up in powers of two.
+ */
+static void bench_softmax_xent(size_t n) {
+    size_t rows = 512;
+    printf("\n=== Softmax cross-entropy, %zu rows x %zu classes ===\n", rows, n);
+
+    FloatMatrix *logits = create_float_matrix(rows, n);
+    FloatMatrix *probs = create_float_matrix(rows, n);
+    FloatMatrix *grad = create_float_matrix(rows, n);
+    size_t *labels = (size_t *)malloc(rows * sizeof(size_t));
+    if (logits == NULL || probs == NULL || grad == NULL || labels == NULL) {
+        dealloc_float_matrix(logits);
+        dealloc_float_matrix(probs);
+        dealloc_float_matrix(grad);
+        free(labels);
+        return;
+    }
+    float_fill_normal(logits, 0.0, 3.0, 6);
+    init_float_zero(probs);
+    init_float_zero(grad);
+    for (size_t r = 0; r < rows; r++) {
+        labels[r] = (r * 7919) % n;
+    }
+
+    printf("%8s %12s %12s %8s\n", "threads", "two-pass s", "fused s", "speedup");
+    for (int threads = 1; threads <= max_bench_threads(); threads *= 2) {
+        set_threads(threads);
+
+        double start = float_wall_seconds();
+        float_softmax(logits, probs);
+        double loss = 0.0;
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t j = 0; j < n; j++) {
+                grad->data[r][j] = (probs->data[r][j] - (j == labels[r] ? 1.0 : 0.0)) / (double)rows;
+            }
+            loss -= log(probs->data[r][labels[r]]) / (double)rows;
+        }
+        double two_pass = float_wall_seconds() - start;
+
+        start = float_wall_seconds();
+        double fused_loss = float_softmax_cross_entropy(logits, labels, grad);
+        double fused = float_wall_seconds() - start;
+
+        printf("%8d %12.4f %12.4f %8.2fx   (loss %.4f / %.4f)\n",
+               threads, two_pass, fused, two_pass / fused, loss, fused_loss);
+    }
+
+    dealloc_float_matrix(logits);
+    dealloc_float_matrix(probs);
+    dealloc_float_matrix(grad);
+    free(labels);
+}
+
+static void bench_fast_activations(size_t n) {
+    printf("\n=== Activations over %zu elements ===\n", n);
+
+    FloatMatrix *in = create_float_matrix(1, n);
+    FloatMatrix *out = create_float_matrix(1, n);
+    if (in == NULL || out == NULL) {
+        dealloc_float_matrix(in);
+        dealloc_float_matrix(out);
+        return;
+    }
+    float_fill_uniform(in, -10.0, 10.0, 4);
+    init_float_zero(out);
+    const double *x = in->data[0];
+    double *y = out->data[0];
+
+    static const char *names[] = { "exp", "sigmoid", "tanh" };
+    printf("%10s %12s %12s %8s\n", "function", "libm Melem/s", "fast Melem/s", "speedup");
+    for (int f = 0; f < 3; f++) {
+        double start = float_wall_seconds();
+        if (f == 0) {
+            #pragma omp parallel for schedule(static)
+            for (long i = 0; i < (long)n; i++) y[i] = exp(x[i]);
+        } else if (f == 1) {
+            sigmoid_array(x, y, n);
+        } else {
+            tanh_array(x, y, n);
+        }
+        double exact_seconds = float_wall_seconds() - start;
+
+        start = float_wall_seconds();
+        if (f == 0) exp_array_fast(x, y, n);
+        else if (f == 1) sigmoid_array_fast(x, y, n);
+        else tanh_array_fast(x, y, n);
+        double fast_seconds = float_wall_seconds() - start;
+
+        printf("%10s %12.1f %12.1f %8.2fx\n", names[f], (double)n / exact_seconds / 1e6,
+               (double)n / fast_seconds / 1e6, exact_seconds / fast_seconds);
+    }
+
+    dealloc_float_matrix(in);
+    dealloc_float_matrix(out);
+}
+
+/*
+ * Samples per second through a training step of a width-n 3-layer MLP.
+ * Batch 1 is one GEMV per layer; larger batches turn each layer into a
+ * GEMM that the blocked kernel can spread over the cores.
+ */
+static void bench_mlp_batches(size_t n) {
+    static const size_t batches[] = { 1, 16, 64, 256 };
+    size_t batch_count = sizeof(batches) / sizeof(batches[0]);
+    size_t samples = 1024;
+    printf("\n=== MLP training, %zu-%zu-%zu-10, %zu samples per epoch ===\n", n, n, n, samples);
+
+    size_t sizes[4] = { n, n, n, 10 };
+    FloatActivation activations[3] = { FLOAT_ACT_RELU, FLOAT_ACT_RELU, FLOAT_ACT_SIGMOID };
+    FloatMatrix *X = create_float_matrix(samples, n);
+    FloatMatrix *Y = create_float_matrix(samples, 10);
+    FloatMLP *mlp = float_mlp_create(sizes, activations, 3, batches[batch_count - 1], 1);
+    if (X == NULL || Y == NULL || mlp == NULL) {
+        dealloc_float_matrix(X);
+        dealloc_float_matrix(Y);
+        dealloc_float_mlp(mlp);
+        return;
+    }
+    float_fill_uniform(X, -1.0, 1.0, 2);
+    float_fill_uniform(Y, 0.0, 1.0, 3);
+
+    printf("%8s %10s %14s %8s\n", "batch", "seconds", "samples/s", "speedup");
+    double base = 0.0;
+    for (size_t b = 0; b < batch_count; b++) {
+        double start = float_wall_seconds();
+        float_mlp_train_epoch(mlp, X, Y, batches[b], 0.01, NULL);
+        double seconds = float_wall_seconds() - start;
+        double rate = (double)samples / seconds;
+        if (b == 0) base = rate;
+        printf("%8zu %10.4f %14.1f %8.2fx\n", batches[b], seconds, rate, rate / base);
+    }
+
+    dealloc_float_matrix(X);
+    dealloc_float_matrix(Y);
+    dealloc_float_mlp(mlp);
+}
+
+static void bench_data_parallel(size_t n) {
+    size_t samples = 2048, batch = 256;
+    printf("\n=== Data-parallel training, %zu-%zu-%zu-10, batch %zu, %zu samples per epoch ===\n",
+           n, n, n, batch, samples);
+
+    size_t sizes[4] = { n, n, n, 10 };
+    FloatActivation activations[3] = { FLOAT_ACT_RELU, FLOAT_ACT_RELU, FLOAT_ACT_SIGMOID };
+    FloatMatrix *X = create_float_matrix(samples, n);
+    FloatMatrix *Y = create_float_matrix(samples, 10);
+    FloatMLP *mlp = float_mlp_create(sizes, activations, 3, batch, 1);
+    if (X == NULL || Y == NULL || mlp == NULL) {
+        dealloc_float_matrix(X);
+        dealloc_float_matrix(Y);
+        dealloc_float_mlp(mlp);
+        return;
+    }
+    float_fill_uniform(X, -1.0, 1.0, 2);
+    float_fill_uniform(Y, 0.0, 1.0, 3);
+    MatrixRng rng;
+    matrix_rng_seed(&rng, 4, 0);
+
+    static const char *modes[] = { "tree", "ring", "hogwild" };
+    printf("%8s %12s %12s %12s   (samples/s, speedup over 1 thread)\n",
+           "threads", modes[0], modes[1], modes[2]);
+    double base[3] = { 0.0, 0.0, 0.0 };
+    for (int threads = 1; threads <= max_bench_threads(); threads *= 2) {
+        printf("%8d", threads);
+        for (int mode = 0; mode < 3; mode++) {
+            FloatDataParallel *dp = float_dp_create(mlp, threads,
+                                                    mode == 1 ? FLOAT_REDUCE_RING : FLOAT_REDUCE_TREE);
+            if (dp == NULL) break;
+            double start = float_wall_seconds();
+            if (mode < 2) {
+                float_dp_train_epoch(dp, X, Y, batch, 0.01, &rng);
+            } else {
+                float_dp_train_epoch_hogwild(dp, X, Y, batch, 0.01, &rng);
+            }
+            double rate = (double)samples / (float_wall_seconds() - start);
+            if (threads == 1) base[mode] = rate;
+            printf(" %9.0f %4.2fx", rate, rate / base[mode]);
+            dealloc_float_dp(dp);
+        }
+        printf("\n");
+    }
+
+    dealloc_float_matrix(X);
+    dealloc_float_matrix(Y);
+    dealloc_float_mlp(mlp);
+}
+
+/*
+ * 16 windows of 32 days of the 20-ticker daily returns, run through LSTM
+ * and GRU layers of n units: once as a single chunk (one input GEMM for
+ * all 32 steps) and once as 32 one-step chunks (an input GEMM per step),
+ * plus a full forward and truncated-BPTT backward pass over the chunk.
+ */
+static void bench_rnn_stocks(size_t n) {
+    size_t tickers = 0, steps = 32, batch = 16;
+    FloatMatrix *returns = load_close_returns("CSV/all_stocks_combined.csv", &tickers);
+    if (returns == NULL) {
+        return;
+    }
+    if (returns->rows < steps + batch) {
+        printf("Not enough trading days for the RNN benchmark\n");
+        dealloc_float_matrix(returns);
+        return;
+    }
+    printf("\n=== LSTM/GRU over %zu windows of %zu days x %zu tickers, %zu units ===\n",
+           batch, steps, tickers, n);
+
+    // Time-major windows: step t of window b is day b * stride + t
+    size_t stride = (returns->rows - steps) / batch;
+    FloatMatrix *inputs = create_float_matrix(steps * batch, tickers);
+    FloatMatrix *d_outputs = create_float_matrix(steps * batch, n);
+    if (inputs == NULL || d_outputs == NULL) {
+        dealloc_float_matrix(inputs);
+        dealloc_float_matrix(d_outputs);
+        dealloc_float_matrix(returns);
+        return;
+    }
+    for (size_t t = 0; t < steps; t++) {
+        for (size_t b = 0; b < batch; b++) {
+            for (size_t k = 0; k < tickers; k++) {
+                inputs->data[t * batch + b][k] = 100.0 * returns->data[b * stride + t][k];
+            }
+        }
+    }
+    float_fill_uniform(d_outputs, -1e-3, 1e-3, 7);
+
+    static const char *names[] = { "LSTM", "GRU" };
+    int repeats = 20;
+    printf("%6s %14s %14s %8s %16s\n", "cell", "per-step ms", "chunked ms", "speedup", "fwd+bwd steps/s");
+    for (int kind = 0; kind < 2; kind++) {
+        FloatRNN *rnn = float_rnn_create(kind == 0 ? FLOAT_CELL_LSTM : FLOAT_CELL_GRU,
+                                         tickers, n, steps, batch, 1);
+        if (rnn == NULL) continue;
+
+        double start = float_wall_seconds();
+        for (int r = 0; r < repeats; r++) {
+            float_rnn_reset_state(rnn);
+            for (size_t t = 0; t < steps; t++) {
+                float_rnn_forward(rnn, inputs->data[t * batch], 1, batch);
+            }
+        }
+        double per_step = (float_wall_seconds() - start) / repeats;
+
+        start = float_wall_seconds();
+        for (int r = 0; r < repeats; r++) {
+            float_rnn_reset_state(rnn);
+            float_rnn_forward(rnn, inputs->data[0], steps, batch);
+        }
+        double chunked = (float_wall_seconds() - start) / repeats;
+
+        start = float_wall_seconds();
+        for (int r = 0; r < repeats; r++) {
+            float_rnn_reset_state(rnn);
+            float_rnn_forward(rnn, inputs->data[0], steps, batch);
+            float_rnn_backward(rnn, inputs->data[0], d_outputs->data[0], NULL);
+        }
+        double training = (float_wall_seconds() - start) / repeats;
+
+        printf("%6s %14.3f %14.3f %7.2fx %16.0f\n", names[kind], 1e3 * per_step, 1e3 * chunked,
+               per_step / chunked, (double)(steps * batch) / training);
+        dealloc_float_rnn(rnn);
+    }
+
+    dealloc_float_matrix(inputs);
+    dealloc_float_matrix(d_outputs);
+    dealloc_float_matrix(returns);
+}
+
+/*
+ * A 5-tap, dilation-2 Conv1D with same padding over the OHLCV channels of
+ * every ticker: the 20 series one call at a time and all in one call,
+ * through im2col + GEMM and through the direct kernel, plus the backward
+ * pass. Each channel is standardised per ticker first.
+ */
+static void bench_conv_stocks(size_t n) {
+    size_t tickers = 0;
+    FloatMatrix *table = load_stock_fields("CSV/all_stocks_combined.csv", &tickers);
+    if (table == NULL) {
+        return;
+    }
+    size_t days = table->rows, kernel = 5, dilation = 2;
+    printf("\n=== Conv1D over %zu tickers x %zu days x 5 channels, %zu filters of %zu taps ===\n",
+           tickers, days, n, kernel);
+
+    FloatConv1D *conv = float_conv1d_create(5, n, kernel, 1, dilation, dilation * (kernel - 1) / 2,
+                                            tickers, days, 1);
+    FloatMatrix *series = create_float_matrix(tickers * days, 5);
+    FloatMatrix *out = create_float_matrix(tickers * days, n);
+    FloatMatrix *d_series = create_float_matrix(tickers * days, 5);
+    if (conv == NULL || series == NULL || out == NULL || d_series == NULL) {
+        dealloc_float_conv1d(conv);
+        dealloc_float_matrix(series);
+        dealloc_float_matrix(out);
+        dealloc_float_matrix(d_series);
+        dealloc_float_matrix(table);
+        return;
+    }
+    for (size_t t = 0; t < tickers; t++) {
+        for (size_t c = 0; c < 5; c++) {
+            double mean = 0.0, square = 0.0;
+            for (size_t d = 0; d < days; d++) {
+                mean += table->data[d][5 * t + c] / (double)days;
+            }
+            for (size_t d = 0; d < days; d++) {
+                double centred = table->data[d][5 * t + c] - mean;
+                square += centred * centred / (double)days;
+            }
+            double scale = (square > 0.0) ? 1.0 / sqrt(square) : 1.0;
+            for (size_t d = 0; d < days; d++) {
+                series->data[t * days + d][c] = (table->data[d][5 * t + c] - mean) * scale;
+            }
+        }
+    }
+    init_float_zero(out);
+    init_float_zero(d_series);
+
+    int repeats = 50;
+    static const char *names[] = { "im2col, one call per ticker", "im2col, all tickers",
+                                   "direct, all tickers", "backward, all tickers" };
+    printf("%30s %12s\n", "", "ms");
+    for (int mode = 0; mode < 4; mode++) {
+        conv->algorithm = (mode == 2) ? FLOAT_CONV_DIRECT : FLOAT_CONV_IM2COL;
+        double start = float_wall_seconds();
+        for (int r = 0; r < repeats; r++) {
+            if (mode == 0) {
+                for (size_t t = 0; t < tickers; t++) {
+                    FloatMatrix *one = float_matrix_view(series->data[t * days], days, 5);
+                    FloatMatrix *one_out = float_matrix_view(out->data[t * days], days, n);
+                    if (one != NULL && one_out != NULL) {
+                        float_conv1d_forward(conv, one, 1, one_out);
+                    }
+                    dealloc_float_matrix(one);
+                    dealloc_float_matrix(one_out);
+                }
+            } else if (mode < 3) {
+                float_conv1d_forward(conv, series, tickers, out);
+            } else {
+                float_conv1d_backward(conv, series, tickers, out, d_series);
+            }
+        }
+        printf("%30s %12.3f\n", names[mode], 1e3 * (float_wall_seconds() - start) / repeats);
+    }
+
+    dealloc_float_conv1d(conv);
+    dealloc_float_matrix(series);
+    dealloc_float_matrix(out);
+    dealloc_float_matrix(d_series);
+    dealloc_float_matrix(table);
+}
+
+/*
+ * Startup cost of serving a saved model: mapping the checkpoint and
+ * running the first forward pass (which faults the weights in) against
+ * copying it into a fresh network. The file is written and read back
+ * through the page cache, so the faults are minor ones.
+ */
+static void bench_checkpoint(size_t n) {
+    size_t sizes[5] = {n, n, n, n, 10};
+    FloatActivation activations[4] = {FLOAT_ACT_RELU, FLOAT_ACT_RELU, FLOAT_ACT_RELU, FLOAT_ACT_SOFTMAX};
+    FloatMLP *mlp = float_mlp_create(sizes, activations, 4, 1, 5);
+    FloatMatrix *input = create_float_matrix(1, n);
+    if (mlp == NULL || input == NULL) {
+        dealloc_float_mlp(mlp);
+        dealloc_float_matrix(input);
+        return;
+    }
+    fill_test_matrix(input, 3);
+    double megabytes = (double)mlp->parameter_count * sizeof(double) / 1e6;
+    printf("\n=== Checkpoint of a %zu-wide MLP (%.0f MB of weights) ===\n", n, megabytes);
+
+    const char *path = "bench_checkpoint.fckpt";
+    double start = float_wall_seconds();
+    int saved = float_checkpoint_save(path, mlp);
+    double save = float_wall_seconds() - start;
+    dealloc_float_mlp(mlp);
+    if (saved != 0) {
+        dealloc_float_matrix(input);
+        return;
+    }
+    printf("%-28s %10.1f ms (%.0f MB/s)\n", "save", save * 1e3, megabytes / save);
+
+    start = float_wall_seconds();
+    FloatCheckpoint *ckpt = float_checkpoint_open(path, 1);
+    double open_time = float_wall_seconds() - start;
+    if (ckpt != NULL) {
+        start = float_wall_seconds();
+        float_mlp_forward(ckpt->mlp, input->data[0]);
+        double first = float_wall_seconds() - start;
+        start = float_wall_seconds();
+        float_mlp_forward(ckpt->mlp, input->data[0]);
+        double warm = float_wall_seconds() - start;
+        printf("%-28s %10.3f ms\n", "mmap open", open_time * 1e3);
+        printf("%-28s %10.1f ms\n", "first forward (page faults)", first * 1e3);
+        printf("%-28s %10.1f ms\n", "warm forward", warm * 1e3);
+        printf("%-28s %10.1f ms\n", "time to first result", (open_time + first) * 1e3);
+        float_checkpoint_close(ckpt);
+    }
+
+    start = float_wall_seconds();
+    FloatMLP *loaded = float_checkpoint_load(path, 1, NULL);
+    double load = float_wall_seconds() - start;
+    if (loaded != NULL) {
+        start = float_wall_seconds();
+        float_mlp_forward(loaded, input->data[0]);
+        double first = float_wall_seconds() - start;
+        printf("%-28s %10.1f ms\n", "copying load", load * 1e3);
+        printf("%-28s %10.1f ms\n", "time to first result", (load + first) * 1e3);
+        dealloc_float_mlp(loaded);
+    }
+
+    remove(path);
+    dealloc_float_matrix(input);
+}
+
+typedef struct BenchCase {
+    const char *name;
+    void (*run)(size_t n);
+    size_t default_size;
+} BenchCase;
+
+static const BenchCase bench_cases[] = {
+    { "lu", bench_lu_scaling, 1536 },
+    { "expr", bench_expr_fusion, 4096 },
+    { "numa", bench_numa_placement, 4096 },
+    { "random", bench_random_fill, 4096 },
+    { "eigen", bench_eigen_scaling, 1000 },
+    { "pca", bench_pca_stocks, 5 },
+    { "svd", bench_randomized_svd, 50000 },
+    { "activ", bench_fast_activations, 1 << 22 },
+    { "softmax", bench_softmax_xent, 50000 },
+    { "mlp", bench_mlp_batches, 1024 },
+    { "optim", bench_optimizers, 10000000 },
+    { "dp", bench_data_parallel, 512 },
+    { "rnn", bench_rnn_stocks, 128 },
+    { "conv", bench_conv_stocks, 64 },
+    { "checkpoint", bench_checkpoint, 4096 },
+    { "autotune", bench_autotune, 512 },
+};
+
+int main(int argc, char **argv) {
+    printf("Matrix Library Benchmarks\n");
+    printf("=========================\n");
+
+    size_t case_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
+    int ran = 0;
+    for (size_t c = 0; c < case_count; c++) {
+        if (argc > 1 && strcmp(argv[1], bench_cases[c].name) != 0) {
+            continue;
+        }
+        // Autotuning rewrites the profile, so it only runs when asked for
+        if (argc <= 1 && bench_cases[c].run == bench_autotune) {
+            continue;
+        }
+        size_t size = bench_cases[c].default_size;
+        if (argc > 2) {
+            size = (size_t)strtoull(argv[2], NULL, 10);
+        }
+        bench_cases[c].run(size);
+        ran = 1;
+    }
+
+    if (!ran) {
+        printf("Unknown benchmark: %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "matrix.h"
+#include "float_matrix.h"
+#include "matrix_random.h"
+
+#define MATRIX_RANDOM_TWO_PI 6.283185307179586
+
+static uint64_t global_seed = 0x853C49E6748FEA9BULL;
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* Independent stream `stream` of generator `seed`, expanded by splitmix64. */
+void matrix_rng_seed(MatrixRng *rng, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&x);
+    }
+}
+
+uint64_t matrix_rng_next(MatrixRng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+/* Top 53 bits as a double in [0, 1). */
+double matrix_rng_uniform(MatrixRng *rng) {
+    return (double)(matrix_rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+/* Seed for init_random and other calls that do not take one explicitly. */
+void matrix_random_seed(uint64_t seed) {
+    #pragma omp critical(matrix_random_seed)
+    global_seed = seed;
+}
+
+uint64_t matrix_random_next_seed(void) {
+    uint64_t state;
+    #pragma omp critical(matrix_random_seed)
+    {
+        state = global_seed;
+        global_seed += 0x9E3779B97F4A7C15ULL;
+    }
+    return splitmix64(&state);
+}
+
+static int fill_in_parallel(size_t count) {
+    return (double)count * 8.0 >= float_tuning()->parallel_threshold;
+}
+
+/* Raw outputs of block b's stream; len is rounded up to even for Box-Muller. */
+static void block_raw(uint64_t *raw, size_t len, uint64_t seed, long block) {
+    MatrixRng rng;
+    matrix_rng_seed(&rng, seed, (uint64_t)block);
+    for (size_t i = 0; i < len; i++) {
+        raw[i] = matrix_rng_next(&rng);
+    }
+}
+
+/* Uniform integers in [min_value, max_value], by multiply-shift rather than modulo. */
+void init_random_seeded(Matrix *m, int min_value, int max_value, uint64_t seed) {
+    if (matrix_make_writable(m) != 0) return;
+    size_t count = m->rows * m->cols;
+    uint64_t range = (uint64_t)((int64_t)max_value - (int64_t)min_value + 1);
+    int *out = m->data[0];
+    long blocks = (long)((count + MATRIX_RANDOM_BLOCK - 1) / MATRIX_RANDOM_BLOCK);
+
+    #pragma omp parallel for schedule(static) if(fill_in_parallel(count))
+    for (long b = 0; b < blocks; b++) {
+        uint64_t raw[MATRIX_RANDOM_BLOCK];
+        size_t start = (size_t)b * MATRIX_RANDOM_BLOCK;
+        size_t len = (count - start < MATRIX_RANDOM_BLOCK) ? count - start : MATRIX_RANDOM_BLOCK;
+        block_raw(raw, len, seed, b);
+        #pragma omp simd
+        for (size_t i = 0; i < len; i++) {
+            out[start + i] = (int)((int64_t)min_value + (int64_t)(((raw[i] >> 32) * range) >> 32));
+        }
+    }
+}
+
+void init_random(Matrix *m, int min_value, int max_value) {
+    init_random_seeded(m, min_value, max_value, matrix_random_next_seed());
+}
+
+void float_fill_uniform(FloatMatrix *m, double low, double high, uint64_t seed) {
+    if (float_make_writable(m) != 0) return;
+    size_t count = m->rows * m->cols;
+    double *out = m->data[0];
+    double width = high - low;
+    long blocks = (long)((count + MATRIX_RANDOM_BLOCK - 1) / MATRIX_RANDOM_BLOCK);
+
+    #pragma omp parallel for schedule(static) if(fill_in_parallel(count))
+    for (long b = 0; b < blocks; b++) {
+        uint64_t raw[MATRIX_RANDOM_BLOCK];
+        size_t start = (size_t)b * MATRIX_RANDOM_BLOCK;
+        size_t len = (count - start < MATRIX_RANDOM_BLOCK) ? count - start : MATRIX_RANDOM_BLOCK;
+        block_raw(raw, len, seed, b);
+        #pragma omp simd
+        for (size_t i = 0; i < len; i++) {
+            out[start + i] = low + width * ((double)(raw[i] >> 11) * 0x1.0p-53);
+        }
+    }
+}
+
+/*
+ * Box-Muller: each pair of uniforms (u1 in (0, 1], u2) gives two
+ * independent normals r cos(2 pi u2) and r sin(2 pi u2), r = sqrt(-2 ln u1).
+ */
+void float_fill_normal(FloatMatrix *m, double mean, double stddev, uint64_t seed) {
+    if (float_make_writable(m) != 0) return;
+    size_t count = m->rows * m->cols;
+    double *out = m->data[0];
+    long blocks = (long)((count + MATRIX_RANDOM_BLOCK - 1) / MATRIX_RANDOM_BLOCK);
+
+    #pragma omp parallel for schedule(static) if(fill_in_parallel(count))
+    for (long b = 0; b < blocks; b++) {
+        uint64_t raw[MATRIX_RANDOM_BLOCK];
+        double values[MATRIX_RANDOM_BLOCK];
+        size_t start = (size_t)b * MATRIX_RANDOM_BLOCK;
+        size_t len = (count - start < MATRIX_RANDOM_BLOCK) ? count - start : MATRIX_RANDOM_BLOCK;
+        size_t pairs = (len + 1) / 2;
+        block_raw(raw, 2 * pairs, seed, b);
+
+        #pragma omp simd
+        for (size_t p = 0; p < pairs; p++) {
+            double u1 = 1.0 - (double)(raw[2 * p] >> 11) * 0x1.0p-53;
+            double u2 = (double)(raw[2 * p + 1] >> 11) * 0x1.0p-53;
+            double r = stddev * sqrt(-2.0 * log(u1));
+            double theta = MATRIX_RANDOM_TWO_PI * u2;
+            values[2 * p] = mean + r * cos(theta);
+            values[2 * p + 1] = mean + r * sin(theta);
+        }
+        memcpy(out + start, values, len * sizeof(double));
+    }
+}
+
+/*
+ * Weights are stored inputs x outputs (as in the network), so fan-in is
+ * the row count and fan-out the column count.
+ * Xavier/Glorot: uniform in +-sqrt(6 / (fan_in + fan_out)), for tanh/sigmoid layers.
+ */
+void float_init_xavier(FloatMatrix *w, uint64_t seed) {
+    double limit = sqrt(6.0 / (double)(w->rows + w->cols));
+    float_fill_uniform(w, -limit, limit, seed);
+}
+
+/* He/Kaiming: normal with standard deviation sqrt(2 / fan_in), for ReLU layers. */
+void float_init_he(FloatMatrix *w, uint64_t seed) {
+    float_fill_normal(w, 0.0, sqrt(2.0 / (double)w->rows), seed);
+}
+
+static void moments(FloatMatrix *m, double *mean, double *stddev) {
+    size_t count = m->rows * m->cols;
+    double sum = 0.0, sum_sq = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += m->data[0][i];
+        sum_sq += m->data[0][i] * m->data[0][i];
+    }
+    *mean = sum / (double)count;
+    *stddev = sqrt(sum_sq / (double)count - *mean * *mean);
+}
+
+void test_matrix_random() {
+    printf("\n=== Testing Random Initialisation ===\n");
+
+    size_t n = 700;
+    FloatMatrix *serial = create_float_matrix(n, n);
+    FloatMatrix *threaded = create_float_matrix(n, n);
+    if (serial == NULL || threaded == NULL) {
+        dealloc_float_matrix(serial);
+        dealloc_float_matrix(threaded);
+        return;
+    }
+
+#ifdef _OPENMP
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    float_fill_normal(serial, 0.0, 1.0, 42);
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    float_fill_normal(threaded, 0.0, 1.0, 42);
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+    int same = memcmp(serial->data[0], threaded->data[0], n * n * sizeof(double)) == 0;
+    printf("Same seed on 1 and 4 threads: %s (expected: identical)\n", same ? "identical" : "DIFFERENT");
+
+    double mean, stddev;
+    moments(serial, &mean, &stddev);
+    printf("Normal(0, 1) mean %.4f, stddev %.4f (expected: ~0, ~1)\n", mean, stddev);
+
+    float_fill_uniform(serial, 2.0, 4.0, 7);
+    moments(serial, &mean, &stddev);
+    printf("Uniform[2, 4) mean %.4f, stddev %.4f (expected: ~3, ~%.4f)\n", mean, stddev, 2.0 / sqrt(12.0));
+
+    FloatMatrix *w = create_float_matrix(300, 100);
+    if (w != NULL) {
+        float_init_xavier(w, 1);
+        double limit = sqrt(6.0 / 400.0), max_abs = 0.0;
+        for (size_t i = 0; i < 300 * 100; i++) {
+            if (fabs(w->data[0][i]) > max_abs) max_abs = fabs(w->data[0][i]);
+        }
+        printf("Xavier max |w| %.4f (expected: <= %.4f)\n", max_abs, limit);
+
+        float_init_he(w, 1);
+        moments(w, &mean, &stddev);
+        printf("He stddev %.4f (expected: ~%.4f)\n", stddev, sqrt(2.0 / 300.0));
+        dealloc_float_matrix(w);
+    }
+
+    Matrix *ints = create_matrix(200, 200);
+    if (ints != NULL) {
+        init_random_seeded(ints, -3, 3, 9);
+        int low = 3, high = -3;
+        for (size_t i = 0; i < 200 * 200; i++) {
+            if (ints->data[0][i] < low) low = ints->data[0][i];
+            if (ints->data[0][i] > high) high = ints->data[0][i];
+        }
+        printf("Integer range [%d, %d] (expected: [-3, 3])\n", low, high);
+        dealloc_matrix(ints);
+    }
+
+    dealloc_float_matrix(serial);
+    dealloc_float_matrix(threaded);
+}
+
+#ifndef NO_RANDOM_MAIN
+int main() {
+    printf("Random Initialisation Test\n");
+    printf("==========================\n");
+
+    test_matrix_random();
+
+    printf("\n✓ All random tests completed!\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,35 @@
+#ifndef MATRIX_RANDOM_H
+#define MATRIX_RANDOM_H
+
+#include <stdint.h>
+#include "matrix.h"
+#include "float_matrix.h"
+
+/*
+ * xoshiro256** streams for matrix initialisation. A fill cuts the
+ * buffer into MATRIX_RANDOM_BLOCK element blocks and seeds block b's
+ * stream from (seed, b), so a given seed gives the same matrix no matter
+ * how many threads share the blocks out.
+ */
+#define MATRIX_RANDOM_BLOCK 1024
+
+typedef struct MatrixRng {
+    uint64_t s[4];
+} MatrixRng;
+
+void matrix_rng_seed(MatrixRng *rng, uint64_t seed, uint64_t stream);
+uint64_t matrix_rng_next(MatrixRng *rng);
+double matrix_rng_uniform(MatrixRng *rng);
+
+void matrix_random_seed(uint64_t seed);
+uint64_t matrix_random_next_seed(void);
+
+void init_random_seeded(Matrix *m, int min_value, int max_value, uint64_t seed);
+void float_fill_uniform(FloatMatrix *m, double low, double high, uint64_t seed);
+void float_fill_normal(FloatMatrix *m, double mean, double stddev, uint64_t seed);
+void float_init_xavier(FloatMatrix *w, uint64_t seed);
+void float_init_he(FloatMatrix *w, uint64_t seed);
+
+void test_matrix_random(void);
+
+#endif